@@ -0,0 +1,11 @@
+#ifndef ALLOCCOUNT_H
+#define ALLOCCOUNT_H
+
+// Heap allocations made through operator new on any thread since startup.
+// alloccount.cpp replaces the global operator new to count them; the cost is
+// one relaxed atomic increment per allocation.
+unsigned long long allocationCount();
+// The same count for the calling thread only
+unsigned long long threadAllocationCount();
+
+#endif // ALLOCCOUNT_H
@@ -0,0 +1,165 @@
+#include "assets.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "parallel.h"
+
+const char* const SPRITE_FILES[SPRITE_COUNT] = {
+    "Dino-stand.png",
+    "Dino-right-up.png",
+    "Dino-left-up.png",
+    "Dino-below-right-up.png",
+    "Dino-below-left-up.png",
+    "Dino-big-eyes.png",
+    "ground.png",
+    "Cactus-1.png",
+    "Cactus-2.png",
+    "Cactus-3.png",
+    "Cactus-4.png",
+    "Cactus-5.png",
+    "Ptero-down.png",
+    "Ptero-up.png"
+};
+
+const char* const FONT_FILE = "arial.ttf";
+
+const int MAX_LOADER_THREADS = 4;
+
+Assets::Assets() : nextJob(0), uploadedCount(0), atlasBuilt(false) {
+    for (int i = 0; i < ASSET_JOBS; ++i) {
+        states[i].store(JOB_PENDING, std::memory_order_relaxed);
+        uploaded[i] = false;
+    }
+}
+
+Assets::~Assets() {
+    join();
+}
+
+bool Assets::start(const std::string& bundlePath) {
+    if (!bundlePath.empty() && bundle.open(bundlePath)) {
+        if (validBundle(bundle, SPRITE_COUNT)) {
+            return loadBundle();
+        }
+        std::cerr << "Ignoring invalid asset bundle " << bundlePath << std::endl;
+        bundle.close();
+    }
+    
+    int threads = std::min(hardwareThreads(), MAX_LOADER_THREADS);
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back(&Assets::decode, this);
+    }
+    return true;
+}
+
+// Worker: claims jobs in SpriteId order, so the dino and ground come first
+void Assets::decode() {
+    for (int job = nextJob.fetch_add(1); job < ASSET_JOBS; job = nextJob.fetch_add(1)) {
+        bool loaded = job < SPRITE_COUNT ? images[job].loadFromFile(SPRITE_FILES[job])
+                                         : decodedFont.loadFromFile(FONT_FILE);
+        states[job].store(loaded ? JOB_DECODED : JOB_FAILED, std::memory_order_release);
+    }
+}
+
+void Assets::join() {
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+bool Assets::poll() {
+    if (complete()) return true;
+    
+    for (int job = 0; job < ASSET_JOBS; ++job) {
+        if (uploaded[job]) continue;
+        int state = states[job].load(std::memory_order_acquire);
+        if (state == JOB_PENDING) continue;
+        
+        if (job == SPRITE_COUNT) {
+            // A missing font only loses the text, as before
+            if (state == JOB_DECODED) {
+                font = decodedFont;
+            }
+        }
+        else if (state == JOB_FAILED || !textures[job].loadFromImage(images[job])) {
+            std::cerr << "Failed to load " << SPRITE_FILES[job] << std::endl;
+            return false;
+        }
+        uploaded[job] = true;
+        uploadedCount++;
+    }
+    
+    // The atlas layout needs every size, so it is packed once all are in
+    if (uploadedCount == ASSET_JOBS) {
+        join();
+        for (int i = 0; i < SPRITE_COUNT; ++i) {
+            atlas.add(images[i]);
+            images[i] = sf::Image();
+        }
+        if (!atlas.build()) {
+            std::cerr << "Failed to build texture atlas!" << std::endl;
+            return false;
+        }
+        atlasBuilt = true;
+    }
+    return true;
+}
+
+bool Assets::ready(int sprite) const {
+    return uploaded[sprite];
+}
+
+bool Assets::fontReady() const {
+    return uploaded[SPRITE_COUNT];
+}
+
+bool Assets::criticalReady() const {
+    for (int i = SPRITE_DINO_STAND; i <= SPRITE_GROUND; ++i) {
+        if (!uploaded[i]) return false;
+    }
+    return true;
+}
+
+bool Assets::complete() const {
+    return atlasBuilt;
+}
+
+float Assets::progress() const {
+    return static_cast<float>(uploadedCount) / ASSET_JOBS;
+}
+
+// Nothing is decoded or copied: textures are uploaded from the mapped pixels
+// and FreeType reads the font in place
+bool Assets::loadBundle() {
+    const BundleHeader* header = reinterpret_cast<const BundleHeader*>(bundle.data());
+    const BundleSprite* sprites = reinterpret_cast<const BundleSprite*>(header + 1);
+    
+    std::vector<sf::IntRect> layout(SPRITE_COUNT);
+    for (int i = 0; i < SPRITE_COUNT; ++i) {
+        layout[i] = sf::IntRect(sprites[i].atlasX, sprites[i].atlasY, sprites[i].width, sprites[i].height);
+    }
+    if (!atlas.create(sf::Vector2u(header->atlasWidth, header->atlasHeight), layout)) {
+        std::cerr << "Failed to create texture atlas!" << std::endl;
+        return false;
+    }
+    
+    for (int i = 0; i < SPRITE_COUNT; ++i) {
+        const sf::Uint8* pixels = bundle.data() + sprites[i].pixelOffset;
+        if (!textures[i].create(sprites[i].width, sprites[i].height)) {
+            std::cerr << "Failed to create texture for " << SPRITE_FILES[i] << std::endl;
+            return false;
+        }
+        textures[i].update(pixels);
+        atlas.update(i, pixels);
+    }
+    
+    if (header->fontSize == 0 || !font.loadFromMemory(bundle.data() + header->fontOffset, header->fontSize)) {
+        font = sf::Font();
+    }
+    
+    std::fill(uploaded, uploaded + ASSET_JOBS, true);
+    uploadedCount = ASSET_JOBS;
+    atlasBuilt = true;
+    return true;
+}
@@ -0,0 +1,87 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "atlas.h"
+#include "bundle.h"
+
+// Dino frames come first and in DinoFrame order
+enum SpriteId {
+    SPRITE_DINO_STAND,
+    SPRITE_DINO_RIGHT_UP,
+    SPRITE_DINO_LEFT_UP,
+    SPRITE_DINO_BELOW_RIGHT_UP,
+    SPRITE_DINO_BELOW_LEFT_UP,
+    SPRITE_DINO_BIG_EYES,
+    SPRITE_GROUND,
+    SPRITE_CACTUS_1,
+    SPRITE_CACTUS_2,
+    SPRITE_CACTUS_3,
+    SPRITE_CACTUS_4,
+    SPRITE_CACTUS_5,
+    SPRITE_PTERO_DOWN,
+    SPRITE_PTERO_UP,
+    SPRITE_COUNT
+};
+
+extern const char* const SPRITE_FILES[SPRITE_COUNT];
+extern const char* const FONT_FILE;
+
+const int ASSET_JOBS = SPRITE_COUNT + 1;    // every sprite, then the font
+
+// Owns every texture and the font. Sprites hold references into it and
+// never copy a texture, so the store must outlive them.
+//
+// A bundle loads in place at once. Loose files are decoded on background
+// threads instead, and the render thread uploads each one as it finishes,
+// so the window can come up before everything is in.
+class Assets {
+public:
+    // The font reads its data straight out of the mapped bundle, so the
+    // mapping is declared first and destroyed last
+    MappedFile bundle;
+    TextureAtlas atlas;
+    sf::Texture textures[SPRITE_COUNT];
+    sf::Font font;
+
+    Assets();
+    ~Assets();
+    // Loads from the bundle at bundlePath if there is a valid one there,
+    // otherwise starts decoding the loose PNGs and font in the working directory
+    bool start(const std::string& bundlePath);
+    // Render thread: uploads what finished decoding since the last call.
+    // Returns false if a sprite could not be loaded.
+    bool poll();
+    
+    bool ready(int sprite) const;
+    bool fontReady() const;
+    bool criticalReady() const;    // dino frames and ground: enough to play
+    bool complete() const;         // everything, atlas included
+    float progress() const;
+
+private:
+    enum JobState {
+        JOB_PENDING,
+        JOB_DECODED,
+        JOB_FAILED
+    };
+    
+    std::vector<std::thread> workers;
+    std::atomic<int> nextJob;
+    std::atomic<int> states[ASSET_JOBS];
+    sf::Image images[SPRITE_COUNT];
+    sf::Font decodedFont;
+    bool uploaded[ASSET_JOBS];
+    int uploadedCount;
+    bool atlasBuilt;
+
+    bool loadBundle();
+    void decode();
+    void join();
+};
+
+#endif // ASSETS_H
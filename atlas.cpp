@@ -0,0 +1,89 @@
+#include "atlas.h"
+#include <algorithm>
+#include <numeric>
+
+const unsigned ATLAS_PADDING = 1;
+
+int TextureAtlas::add(const sf::Image& image) {
+    images.push_back(image);
+    return static_cast<int>(images.size()) - 1;
+}
+
+// Shelf packing: tallest images first, rows as wide as the widest image
+sf::Vector2u packFrames(const std::vector<sf::Vector2u>& sizes, std::vector<sf::IntRect>& frames) {
+    std::vector<int> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&sizes](int a, int b) {
+        return sizes[a].y > sizes[b].y;
+    });
+    
+    unsigned atlasWidth = 0;
+    for (const auto& size : sizes) {
+        atlasWidth = std::max(atlasWidth, size.x);
+    }
+    
+    frames.assign(sizes.size(), sf::IntRect());
+    unsigned x = 0, y = 0, rowHeight = 0;
+    for (int index : order) {
+        sf::Vector2u size = sizes[index];
+        if (x + size.x > atlasWidth) {
+            x = 0;
+            y += rowHeight + ATLAS_PADDING;
+            rowHeight = 0;
+        }
+        frames[index] = sf::IntRect(x, y, size.x, size.y);
+        x += size.x + ATLAS_PADDING;
+        rowHeight = std::max(rowHeight, size.y);
+    }
+    return sf::Vector2u(atlasWidth, y + rowHeight);
+}
+
+bool TextureAtlas::build() {
+    std::vector<sf::Vector2u> sizes;
+    for (const auto& image : images) {
+        sizes.push_back(image.getSize());
+    }
+    sf::Vector2u size = packFrames(sizes, frames);
+    
+    sf::Image packed;
+    packed.create(size.x, size.y, sf::Color::Transparent);
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        packed.copy(images[i], frames[i].left, frames[i].top);
+    }
+    images.clear();
+    return texture.loadFromImage(packed);
+}
+
+// The padding between frames is left uninitialised; sampling is nearest and
+// stays inside each frame, so it is never read
+bool TextureAtlas::create(const sf::Vector2u& size, const std::vector<sf::IntRect>& layout) {
+    frames = layout;
+    return texture.create(size.x, size.y);
+}
+
+void TextureAtlas::update(int index, const sf::Uint8* pixels) {
+    const sf::IntRect& frame = frames[index];
+    texture.update(pixels, frame.width, frame.height, frame.left, frame.top);
+}
+
+const sf::Texture& TextureAtlas::getTexture() const {
+    return texture;
+}
+
+const sf::IntRect& TextureAtlas::getFrame(int index) const {
+    return frames[index];
+}
+
+void appendQuad(sf::VertexArray& vertices, const sf::IntRect& frame, float x, float y, float scale) {
+    float width = frame.width * scale;
+    float height = frame.height * scale;
+    float left = static_cast<float>(frame.left);
+    float top = static_cast<float>(frame.top);
+    float right = left + frame.width;
+    float bottom = top + frame.height;
+    
+    vertices.append(sf::Vertex(sf::Vector2f(x, y), sf::Vector2f(left, top)));
+    vertices.append(sf::Vertex(sf::Vector2f(x + width, y), sf::Vector2f(right, top)));
+    vertices.append(sf::Vertex(sf::Vector2f(x + width, y + height), sf::Vector2f(right, bottom)));
+    vertices.append(sf::Vertex(sf::Vector2f(x, y + height), sf::Vector2f(left, bottom)));
+}
@@ -0,0 +1,30 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Packs many images into one texture so a frame can be drawn in one call
+class TextureAtlas {
+public:
+    int add(const sf::Image& image);
+    bool build();
+    // Layout computed offline (see packassets.cpp): allocate the texture for
+    // these frames, then upload each frame's pixels with update()
+    bool create(const sf::Vector2u& size, const std::vector<sf::IntRect>& layout);
+    void update(int index, const sf::Uint8* pixels);
+    const sf::Texture& getTexture() const;
+    const sf::IntRect& getFrame(int index) const;
+
+private:
+    std::vector<sf::Image> images;
+    std::vector<sf::IntRect> frames;
+    sf::Texture texture;
+};
+
+// Shelf layout of images of these sizes; returns the atlas size
+sf::Vector2u packFrames(const std::vector<sf::Vector2u>& sizes, std::vector<sf::IntRect>& frames);
+
+void appendQuad(sf::VertexArray& vertices, const sf::IntRect& frame, float x, float y, float scale = 1);
+
+#endif // ATLAS_H
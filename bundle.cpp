@@ -0,0 +1,101 @@
+#include "bundle.h"
+#include <algorithm>
+#include <climits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#endif
+
+MappedFile::MappedFile() : address(nullptr), length(0) {
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void* mapped = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+
+    address = mapped;
+    length = static_cast<std::size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (address) {
+        munmap(address, length);
+        address = nullptr;
+        length = 0;
+    }
+}
+
+const unsigned char* MappedFile::data() const {
+    return static_cast<const unsigned char*>(address);
+}
+
+std::size_t MappedFile::size() const {
+    return length;
+}
+
+static bool inside(const MappedFile& file, std::uint64_t offset, std::uint64_t size) {
+    return offset % 4 == 0 && offset <= file.size() && size <= file.size() - offset;
+}
+
+bool validBundle(const MappedFile& file, std::uint32_t spriteCount) {
+    if (file.size() < sizeof(BundleHeader)) return false;
+    const BundleHeader* header = reinterpret_cast<const BundleHeader*>(file.data());
+    if (!std::equal(BUNDLE_MAGIC, BUNDLE_MAGIC + 4, header->magic) ||
+        header->version != BUNDLE_VERSION || header->spriteCount != spriteCount ||
+        !inside(file, sizeof(BundleHeader), std::uint64_t(spriteCount) * sizeof(BundleSprite)) ||
+        !inside(file, header->fontOffset, header->fontSize)) {
+        return false;
+    }
+
+    const BundleSprite* sprites = reinterpret_cast<const BundleSprite*>(header + 1);
+    for (std::uint32_t i = 0; i < spriteCount; ++i) {
+        const BundleSprite& sprite = sprites[i];
+        if (!inside(file, sprite.pixelOffset, std::uint64_t(sprite.width) * sprite.height * 4) ||
+            std::uint64_t(sprite.atlasX) + sprite.width > header->atlasWidth ||
+            std::uint64_t(sprite.atlasY) + sprite.height > header->atlasHeight) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string executableDirectory(const char* argv0) {
+    std::string path;
+#ifdef __APPLE__
+    char buffer[PATH_MAX];
+    std::uint32_t size = sizeof(buffer);
+    if (_NSGetExecutablePath(buffer, &size) == 0) {
+        path = buffer;
+    }
+#else
+    char buffer[PATH_MAX];
+    ssize_t size = readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
+    if (size > 0) {
+        path.assign(buffer, static_cast<std::size_t>(size));
+    }
+#endif
+    if (path.empty() && argv0) {
+        path = argv0;
+    }
+
+    std::size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+}
@@ -0,0 +1,60 @@
+#ifndef BUNDLE_H
+#define BUNDLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// dino.bundle, written offline by packassets.cpp: every sprite decoded to
+// RGBA together with its place in the texture atlas, followed by the font.
+// All fields are 32-bit in the packing machine's byte order (a bundle from the
+// other endianness fails the version check) and every section starts 4-byte
+// aligned, so the game reads the file in place from a read-only mapping.
+const char BUNDLE_MAGIC[4] = {'D', 'B', 'D', 'L'};
+const std::uint32_t BUNDLE_VERSION = 1;
+const char BUNDLE_FILE_NAME[] = "dino.bundle";
+
+struct BundleHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t spriteCount;
+    std::uint32_t atlasWidth;
+    std::uint32_t atlasHeight;
+    std::uint32_t fontOffset;
+    std::uint32_t fontSize;
+};
+
+// Followed by spriteCount of these, in SpriteId order
+struct BundleSprite {
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t atlasX;
+    std::uint32_t atlasY;
+    std::uint32_t pixelOffset;    // width * height RGBA pixels
+};
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    const unsigned char* data() const;
+    std::size_t size() const;
+
+private:
+    void* address;
+    std::size_t length;
+};
+
+// Checks the header and that every section lies inside the file
+bool validBundle(const MappedFile& file, std::uint32_t spriteCount);
+
+// Directory of the running executable with a trailing slash, or "" if unknown
+std::string executableDirectory(const char* argv0);
+
+#endif // BUNDLE_H
@@ -0,0 +1,59 @@
+#include "collision.h"
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Moves rows of `b` into `a`'s columns (towards higher bits when b sits to the
+// right) and ANDs them. |dx| < 64 whenever the masks can overlap at all.
+static bool rowsOverlap(const std::uint64_t* a, const std::uint64_t* b, int count, int dx) {
+    int i = 0;
+#if defined(__AVX2__)
+    __m128i left = _mm_cvtsi32_si128(dx > 0 ? dx : 0);
+    __m128i right = _mm_cvtsi32_si128(dx < 0 ? -dx : 0);
+    for (; i + 4 <= count; i += 4) {
+        __m256i rowsA = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i rowsB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        rowsB = _mm256_srl_epi64(_mm256_sll_epi64(rowsB, left), right);
+        if (!_mm256_testz_si256(rowsA, rowsB)) return true;
+    }
+#elif defined(__SSE2__)
+    __m128i left = _mm_cvtsi32_si128(dx > 0 ? dx : 0);
+    __m128i right = _mm_cvtsi32_si128(dx < 0 ? -dx : 0);
+    for (; i + 2 <= count; i += 2) {
+        __m128i rowsA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i rowsB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        rowsB = _mm_srl_epi64(_mm_sll_epi64(rowsB, left), right);
+        __m128i hit = _mm_and_si128(rowsA, rowsB);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(hit, _mm_setzero_si128())) != 0xFFFF) return true;
+    }
+#elif defined(__ARM_NEON)
+    int64x2_t shift = vdupq_n_s64(dx);
+    for (; i + 2 <= count; i += 2) {
+        uint64x2_t rowsA = vld1q_u64(a + i);
+        uint64x2_t rowsB = vshlq_u64(vld1q_u64(b + i), shift);
+        uint64x2_t hit = vandq_u64(rowsA, rowsB);
+        if ((vgetq_lane_u64(hit, 0) | vgetq_lane_u64(hit, 1)) != 0) return true;
+    }
+#endif
+    for (; i < count; ++i) {
+        std::uint64_t row = dx >= 0 ? b[i] << dx : b[i] >> -dx;
+        if (a[i] & row) return true;
+    }
+    return false;
+}
+
+bool masksOverlap(const HitMask& a, const HitMask& b, int dx, int dy) {
+    if (dx >= a.width || -dx >= b.width) return false;
+    
+    int top = std::max(0, dy);
+    int bottom = std::min(a.height, dy + b.height);
+    if (top >= bottom) return false;
+    
+    return rowsOverlap(a.rows + top, b.rows + (top - dy), bottom - top, dx);
+}
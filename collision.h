@@ -0,0 +1,24 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <cstdint>
+#include "dinosim.h"
+
+// 1-bit alpha mask of a sprite frame: bit x of rows[y] is set where pixel
+// (x, y) is opaque. Every sprite in the game is at most 64 pixels wide.
+struct HitMask {
+    int width;
+    int height;
+    const std::uint64_t* rows;
+};
+
+// Generated from the PNGs by maskgen.cpp into hitmasks.cpp
+extern const HitMask DINO_MASKS[DINO_FRAME_COUNT];
+extern const HitMask CACTUS_MASKS[CACTUS_TYPES];
+extern const HitMask PTERO_MASKS[2];
+
+// True if any opaque pixel of `b`, placed (dx, dy) pixels from the top-left
+// of `a`, lands on an opaque pixel of `a`.
+bool masksOverlap(const HitMask& a, const HitMask& b, int dx, int dy);
+
+#endif // COLLISION_H
@@ -1,22 +1,70 @@
 #include "dinogame.h"
-#include <iostream>
+#include "alloccount.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
-#include <ctime>
+#include <cstring>
+#include <iostream>
+
+const float FAST_FORWARD_SCALE = 100.0f;
+const int MAX_TICKS_PER_FRAME = 250;
+const int REPLAY_SCRUB_TICKS = 5 * TICKS_PER_SECOND;
+const double AUTOPILOT_FRAME_BUDGET = 0.004;    // seconds of search per frame
+
+// Low-latency mode polls input this long before a tick, and gives up on
+// that tick's snapshot this long after it
+const FramePacer::Clock::duration INPUT_LEAD = std::chrono::microseconds(1000);
+const FramePacer::Clock::duration SNAPSHOT_WAIT_LIMIT = std::chrono::microseconds(4000);
+
+// Placeholder frame shown until the dino and ground have loaded
+const std::chrono::milliseconds LOADING_FRAME_SLEEP(5);
 
-const int WINDOW_WIDTH = 800;
-const int WINDOW_HEIGHT = 300;
-const float GRAVITY = 0.5f;
-const float JUMP_FORCE = -12.0f;
-const float INITIAL_OBSTACLE_SPEED = 5.0f;
-const float INITIAL_GROUND_SPEED = 4.0f;
-const float DINO_ANIMATION_SPEED = 0.15f;
-const float PTERO_SPAWN_INTERVAL = 5.0f;
-const float CACTUS_SPAWN_INTERVAL = 1.5f;
-const int GROUND_OFFSET_Y = -10;
-const float SPEED_INCREASE_FACTOR = 0.2f;
-const float SPEED_INCREASE_INTERVAL = 30.0f;
+// Frames allowed to allocate while glyphs, buffers and the driver warm up
+const long long ALLOC_CHECK_WARMUP_FRAMES = 300;
+
+// Profiling overlay layout; the graph spans two 60 Hz frames
+const float PROFILER_X = 440;
+const float PROFILER_GRAPH_Y = 170;
+const float PROFILER_GRAPH_HEIGHT = 60;
+const float PROFILER_GRAPH_MICROS = 2 * 1e6f / 60;
+
+// Keyboard input goes through the replay so every game can be saved and re-run
+void DinoGame::applyInput(int type) {
+    if (playingReplay) return;
+    
+    // Only a game past the reserved hour grows the event list; the allocation
+    // check is told about it like a save
+    unsigned long long before = threadAllocationCount();
+    replay.record(sim, type);
+    replayAllocations += threadAllocationCount() - before;
+    switch (type) {
+        case REPLAY_JUMP: sim.jump(); break;
+        case REPLAY_DUCK_PRESS: sim.setDucking(true); break;
+        case REPLAY_DUCK_RELEASE: sim.setDucking(false); break;
+    }
+}
 
+void DinoGame::seekReplay(int tick) {
+    replayCursor = replay.seek(sim, tick < 0 ? 0 : tick);
+    accumulator = 0;
+    previousDino = sim.dino;
+    previousGroundOffset = sim.groundOffset;
+}
+
+// Turns a bot's choice into the same inputs a player would give
+void DinoGame::applyBotAction(int action) {
+    if (action == ACTION_JUMP && !sim.dino.isJumping) {
+        applyInput(REPLAY_JUMP);
+    }
+    if ((action == ACTION_DUCK) != sim.dino.isDucking) {
+        applyInput(action == ACTION_DUCK ? REPLAY_DUCK_PRESS : REPLAY_DUCK_RELEASE);
+    }
+}
+
+// Keys that change the game become commands for the simulation thread
 void DinoGame::handleEvents() {
+    ScopedTimer timer(PROFILE_EVENTS);
     sf::Event event;
     while (window.pollEvent(event)) {
         if (event.type == sf::Event::Closed) {
@@ -25,292 +73,608 @@ void DinoGame::handleEvents() {
         
         if (event.type == sf::Event::KeyPressed) {
             if (event.key.code == sf::Keyboard::Space) {
-                if (!isJumping && !gameOver) {
-                    dinoVelocity = JUMP_FORCE;
-                    isJumping = true;
-                } else if (gameOver) {
-                    resetGame();
-                }
+                sendCommand(COMMAND_SPACE);
             }
             else if (event.key.code == sf::Keyboard::Down) {
-                isDucking = true;
+                sendCommand(COMMAND_DUCK_PRESS);
+            }
+            else if (event.key.code == sf::Keyboard::Left) {
+                sendCommand(COMMAND_SCRUB_BACK);
+            }
+            else if (event.key.code == sf::Keyboard::Right) {
+                sendCommand(COMMAND_SCRUB_FORWARD);
+            }
+            else if (event.key.code == sf::Keyboard::Tab) {
+                sendCommand(COMMAND_FAST_FORWARD);
+            }
+            else if (event.key.code == sf::Keyboard::B) {
+                batchedRendering = !batchedRendering;
+            }
+            else if (event.key.code == sf::Keyboard::V && !lowLatency) {
+                setVsync(!vsync);
+            }
+            else if (event.key.code == sf::Keyboard::L) {
+                setLowLatency(!lowLatency);
+            }
+            else if (event.key.code == sf::Keyboard::P) {
+                showProfiler = !showProfiler;
+                profilingMode.fetch_xor(PROFILE_OVERLAY, std::memory_order_relaxed);
+            }
+            else if (event.key.code == sf::Keyboard::A) {
+                sendCommand(COMMAND_AUTOPILOT);
+            }
+            else if (event.key.code == sf::Keyboard::G) {
+                sendCommand(COMMAND_GENOME);
             }
         }
         else if (event.type == sf::Event::KeyReleased) {
             if (event.key.code == sf::Keyboard::Down) {
-                isDucking = false;
+                sendCommand(COMMAND_DUCK_RELEASE);
             }
         }
     }
 }
 
-void DinoGame::updateGround() {
-    if (gameOver) return;
+void DinoGame::sendCommand(GameCommand command) {
+    InputEvent input = {command, FramePacer::Clock::now()};
+    commands.push(input);
+}
+
+// Vsync presents at the display's refresh rate; off, frames are uncapped
+void DinoGame::setVsync(bool enabled) {
+    vsync = enabled;
+    window.setVerticalSyncEnabled(enabled);
+}
+
+// Low latency presents without vsync, one frame per tick right after it
+void DinoGame::setLowLatency(bool enabled) {
+    lowLatency = enabled;
+    window.setVerticalSyncEnabled(vsync && !enabled);
+    latencySamples = 0;
+    latencySum = 0;
+    latencyMax = 0;
+}
+
+// Polls input just before the simulation's next tick, then waits for that
+// tick's snapshot, so a key press is simulated and shown within one frame
+void DinoGame::syncToTick() {
+    FramePacer::Clock::time_point tick{FramePacer::Clock::duration(nextTickTime.load(std::memory_order_acquire))};
+    
+    renderPacer.waitUntil(tick - INPUT_LEAD);
+    snapshots.update();
+    handleEvents();
     
-    groundOffset += groundScrollSpeed;
-    if (groundOffset > 1200) {
-        groundOffset = 0;
+    while (!snapshots.update() && FramePacer::Clock::now() < tick + SNAPSHOT_WAIT_LIMIT) {
+        std::this_thread::yield();
     }
+}
+
+// Input-to-present time for the newest input in each presented snapshot,
+// measured from when handleEvents polled it
+void DinoGame::measureLatency(const Snapshot& view) {
+    if (view.inputSequence == presentedInput) return;
+    presentedInput = view.inputSequence;
+    if (!lowLatency) return;
     
-    ground1.setPosition(-groundOffset, WINDOW_HEIGHT - 12 + GROUND_OFFSET_Y);
-    ground2.setPosition(1200 - groundOffset, WINDOW_HEIGHT - 12 + GROUND_OFFSET_Y);
+    double latency = std::chrono::duration<double, std::milli>(FramePacer::Clock::now() - view.inputTime).count();
+    latencySamples++;
+    latencySum += latency;
+    latencyMax = std::max(latencyMax, latency);
 }
 
-void DinoGame::updateDino() {
-    if (gameOver) return;
+// Positions are drawn between the last two ticks, one tick behind the
+// simulation, so motion is smooth at any refresh rate. Everything but the
+// dino scrolls at a constant speed, so only the dino needs its old state.
+void DinoGame::interpolate(const Snapshot& view) {
+    ScopedTimer timer(PROFILE_INTERPOLATE);
+    pose = view.sim;
+    if (pose.gameOver) return;
     
-    dinoVelocity += GRAVITY;
-    dino.move(0, dinoVelocity);
+    float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - view.publishTime).count();
+    float alpha = (view.accumulator + elapsed * view.timeScale) / TICK_SECONDS;
+    alpha = std::max(0.0f, std::min(alpha, 1.0f));
+    float behind = 1.0f - alpha;
     
-    float groundLevel = WINDOW_HEIGHT - 7 - (isDucking ? 28 : 45) + GROUND_OFFSET_Y;
-    if (dino.getPosition().y >= groundLevel) {
-        dino.setPosition(dino.getPosition().x, groundLevel);
-        dinoVelocity = 0;
-        isJumping = false;
+    pose.dino.y = view.previousDino.y + (pose.dino.y - view.previousDino.y) * alpha;
+    for (int i = 0; i < pose.obstacles.size(); ++i) {
+        pose.obstacles[i].x += behind * pose.obstacleSpeed;
     }
+    
+    // The ground offset wraps back to 0 past 1200
+    float ground = pose.groundOffset;
+    if (ground < view.previousGroundOffset) ground += 1200;
+    pose.groundOffset = view.previousGroundOffset + (ground - view.previousGroundOffset) * alpha;
+    if (pose.groundOffset > 1200) pose.groundOffset -= 1200;
 }
 
-void DinoGame::updateDinoAnimation(float dt) {
-    if (gameOver) return;
-    
-    dinoAnimationTimer += dt;
-    
-    if (dinoAnimationTimer >= DINO_ANIMATION_SPEED) {
-        dinoAnimationTimer = 0;
-        
-        if (isDucking) {
-            dinoAnimationState = (dinoAnimationState + 1) % 2;
-            
-            switch (dinoAnimationState) {
-                case 0: dino.setTexture(dinoBelowRightUpTexture); break;
-                case 1: dino.setTexture(dinoBelowLeftUpTexture); break;
-            }
-        }
-        else if (!isJumping) {
-            dinoAnimationState = (dinoAnimationState + 1) % 3;
-            
-            switch (dinoAnimationState) {
-                case 0: dino.setTexture(dinoStandTexture); break;
-                case 1: dino.setTexture(dinoRightUpTexture); break;
-                case 2: dino.setTexture(dinoLeftUpTexture); break;
-            }
-        } else {
-            dino.setTexture(dinoStandTexture);
+void DinoGame::applyCommands() {
+    ScopedTimer timer(PROFILE_COMMANDS);
+    InputEvent input;
+    while (commands.pop(input)) {
+        inputSequence++;
+        inputTime = input.time;
+        switch (input.command) {
+            case COMMAND_SPACE:
+                if (playingReplay) {
+                    if (sim.gameOver) seekReplay(0);
+                } else if (sim.gameOver) {
+                    // Each restart plays the next seed, so a session is reproducible from its first one
+                    resetGame(sim.seed + 1);
+                } else {
+                    applyInput(REPLAY_JUMP);
+                }
+                break;
+            case COMMAND_DUCK_PRESS:
+                applyInput(REPLAY_DUCK_PRESS);
+                break;
+            case COMMAND_DUCK_RELEASE:
+                applyInput(REPLAY_DUCK_RELEASE);
+                break;
+            case COMMAND_SCRUB_BACK:
+                if (playingReplay) seekReplay(sim.gameTicks - REPLAY_SCRUB_TICKS);
+                break;
+            case COMMAND_SCRUB_FORWARD:
+                if (playingReplay) seekReplay(sim.gameTicks + REPLAY_SCRUB_TICKS);
+                break;
+            case COMMAND_FAST_FORWARD:
+                fastForward = !fastForward;
+                break;
+            case COMMAND_AUTOPILOT:
+                if (!playingReplay) autopilot = !autopilot;
+                break;
+            case COMMAND_GENOME:
+                if (!playingReplay && genomeGeneration >= 0) genomePlaying = !genomePlaying;
+                break;
         }
     }
 }
 
-void DinoGame::updateCacti() {
-    if (gameOver) return;
-    
-    if (obstacleClock.getElapsedTime().asSeconds() > CACTUS_SPAWN_INTERVAL) {
-        if (rand() % 100 < 30) {
-            sf::Sprite cactus;
-            int cactusType = rand() % 5;
-            switch (cactusType) {
-                case 0: cactus.setTexture(cactus1Texture); break;
-                case 1: cactus.setTexture(cactus2Texture); break;
-                case 2: cactus.setTexture(cactus3Texture); break;
-                case 3: cactus.setTexture(cactus4Texture); break;
-                case 4: cactus.setTexture(cactus5Texture); break;
-            }
-            cactus.setPosition(WINDOW_WIDTH, WINDOW_HEIGHT - 7 - cactus.getGlobalBounds().height + GROUND_OFFSET_Y);
-            cacti.push_back(cactus);
+// Score and speed are only reformatted when they change, and then only the
+// glyph quads that differ are rewritten
+void DinoGame::updateText(const Snapshot& view) {
+    const DinoSim& sim = view.sim;
+    char line[96];
+    if (sim.score != shownScore) {
+        shownScore = sim.score;
+        std::snprintf(line, sizeof(line), "%d", sim.score);
+        int quads = scoreCounter.set(line);
+        if (profilingMode.load(std::memory_order_relaxed) & PROFILE_TRACE) {
+            traceInstant("Score text", quads);
         }
-        obstacleClock.restart();
+    }
+    if (sim.speedLevel() != shownSpeedLevel) {
+        shownSpeedLevel = sim.speedLevel();
+        std::snprintf(line, sizeof(line), "%.2f", 1 + shownSpeedLevel * SPEED_INCREASE_FACTOR / INITIAL_OBSTACLE_SPEED);
+        speedCounter.set(line);
     }
     
-    for (size_t i = 0; i < cacti.size(); ) {
-        cacti[i].move(-obstacleSpeed, 0);
-        
-        if (cacti[i].getPosition().x < -50) {
-            cacti.erase(cacti.begin() + i);
-        } else {
-            if (dino.getGlobalBounds().intersects(cacti[i].getGlobalBounds())) {
-                gameOver = true;
-                dino.setTexture(dinoBigEyesTexture);
-            }
-            i++;
-        }
+    if (view.autopilot) {
+        std::snprintf(line, sizeof(line), "Autopilot: %lld nodes/frame, depth %d ticks",
+                      view.plannerNodes - shownPlannerNodes, view.plannerDepth * PLAN_SEGMENT_TICKS);
+        botText.set(line);
+    }
+    else if (view.genomePlaying) {
+        std::snprintf(line, sizeof(line), "Genome: generation %d", genomeGeneration);
+        botText.set(line);
+    }
+    if (lowLatency && latencySamples != shownLatencySamples) {
+        shownLatencySamples = latencySamples;
+        double average = latencySamples ? latencySum / latencySamples : 0;
+        std::snprintf(line, sizeof(line), "Input to present: avg %.2f ms, max %.2f ms", average, latencyMax);
+        latencyText.set(line);
     }
 }
 
-void DinoGame::updatePteros(float dt) {
-    if (gameOver) return;
+// Allocation check: after warm-up, any operator new during a frame is a bug.
+// Each thread counts its own, less what replay saves and growth, the overlay
+// and the trace allocated; the sim publishes its count with the snapshot, so a save
+// is accounted for by the time a frame can see it. Frames where the game ends
+// or restarts (game-over text is laid out) and frames while assets are still
+// arriving are exempt.
+void DinoGame::checkAllocations(const Snapshot& view) {
+    unsigned long long render = threadAllocationCount() - overlayAllocations - traceThreadAllocations();
+    unsigned long long allocations = (render - renderAllocations) + (view.simAllocations - simAllocations);
+    renderAllocations = render;
+    simAllocations = view.simAllocations;
     
-    for (auto& ptero : pteros) {
-        ptero.update(dt, obstacleSpeed);
-        
-        if (ptero.active && dino.getGlobalBounds().intersects(ptero.sprite.getGlobalBounds())) {
-            gameOver = true;
-            dino.setTexture(dinoBigEyesTexture);
+    bool transition = view.sim.gameOver != lastGameOver;
+    lastGameOver = view.sim.gameOver;
+    if (!allocCheck || ++frameCount <= ALLOC_CHECK_WARMUP_FRAMES) return;
+    if (allocations == 0 || transition || !assets.complete()) return;
+    
+    std::cerr << "Allocation check failed: " << allocations << " heap allocations in frame "
+              << frameCount << " (tick " << view.sim.gameTicks << ")" << std::endl;
+    std::abort();
+}
+
+void DinoGame::update(float dt) {
+    accumulator += dt * (fastForward ? FAST_FORWARD_SCALE : 1.0f);
+    
+    // Share the search budget between the ticks due this frame
+    int ticksDue = static_cast<int>(accumulator / TICK_SECONDS);
+    double tickBudget = AUTOPILOT_FRAME_BUDGET / std::max(1, std::min(ticksDue, MAX_TICKS_PER_FRAME));
+    
+    bool wasOver = sim.gameOver;
+    int ticks = 0;
+    while (accumulator >= TICK_SECONDS) {
+        if (ticks == MAX_TICKS_PER_FRAME) {
+            // Too far behind to catch up; drop the backlog instead of spiralling
+            accumulator = 0;
+            break;
+        }
+        if (playingReplay) {
+            replayCursor = replay.applyEvents(sim, replayCursor);
+        }
+        else if (autopilot && !sim.gameOver) {
+            ScopedTimer timer(PROFILE_BOTS);
+            applyBotAction(planner.choose(sim, tickBudget));
+            plannerNodes += planner.nodes;
+        }
+        else if (genomePlaying && !sim.gameOver) {
+            ScopedTimer timer(PROFILE_BOTS);
+            float obs[OBS_SIZE];
+            observe(sim, obs);
+            applyBotAction(genomeAction(genome, obs));
         }
+        previousDino = sim.dino;
+        previousGroundOffset = sim.groundOffset;
+        unsigned pushes = sim.obstacles.pushCount();
+        int level = sim.speedLevel();
+        {
+            ScopedTimer timer(PROFILE_STEP);
+            sim.step();
+        }
+        if (profilingMode.load(std::memory_order_relaxed) & PROFILE_TRACE) {
+            traceStep(pushes, level);
+        }
+        accumulator -= TICK_SECONDS;
+        ticks++;
     }
     
-    if (pteroSpawnClock.getElapsedTime().asSeconds() > PTERO_SPAWN_INTERVAL) {
-        if (rand() % 100 < 20) {
-            float height = WINDOW_HEIGHT - 12 - 50 + GROUND_OFFSET_Y - (rand() % 100);
-            
-            for (auto& ptero : pteros) {
-                if (!ptero.active) {
-                    ptero.spawn(WINDOW_WIDTH, height, obstacleSpeed);
-                    break;
-                }
-            }
+    if (sim.gameOver && !wasOver && !playingReplay) {
+        replay.finish(sim);
+        unsigned long long before = threadAllocationCount();
+        if (!recordPath.empty() && !replay.save(recordPath)) {
+            std::cerr << "Failed to save replay to " << recordPath << std::endl;
         }
-        pteroSpawnClock.restart();
+        replayAllocations += threadAllocationCount() - before;
     }
 }
 
-void DinoGame::updateScore() {
-    if (gameOver) return;
-    
-    if (scoreClock.getElapsedTime().asSeconds() > 0.1f) {
-        score += 1;
-        scoreClock.restart();
+// Game events of the tick just simulated, as trace instants
+void DinoGame::traceStep(unsigned pushesBefore, int levelBefore) {
+    int spawned = static_cast<int>(sim.obstacles.pushCount() - pushesBefore);
+    for (int i = sim.obstacles.size() - spawned; i < sim.obstacles.size(); ++i) {
+        bool cactus = sim.obstacles[i].kind == OBSTACLE_CACTUS;
+        traceInstant(cactus ? "Cactus spawn" : "Pterodactyl spawn", sim.gameTicks);
+    }
+    if (sim.gameOver) {
+        traceInstant("Collision", sim.gameTicks);
+    }
+    if (sim.speedLevel() != levelBefore) {
+        traceInstant("Speed level", sim.speedLevel());
     }
-    scoreText.setString("Score: " + std::to_string(score));
 }
 
-void DinoGame::updateGameSpeed() {
-    if (gameOver) return;
-    
-    gameTime = gameTimeClock.getElapsedTime().asSeconds();
-    int speedLevel = static_cast<int>(gameTime / SPEED_INCREASE_INTERVAL);
-    obstacleSpeed = INITIAL_OBSTACLE_SPEED + speedLevel * SPEED_INCREASE_FACTOR;
-    groundScrollSpeed = INITIAL_GROUND_SPEED + speedLevel * SPEED_INCREASE_FACTOR;
-    
-    speedText.setString("Speed: x" + std::to_string(1 + speedLevel * SPEED_INCREASE_FACTOR / INITIAL_OBSTACLE_SPEED).substr(0, 4));
+void DinoGame::publish() {
+    ScopedTimer timer(PROFILE_PUBLISH);
+    Snapshot& out = snapshots.back();
+    out.sim = sim;
+    out.previousDino = previousDino;
+    out.previousGroundOffset = previousGroundOffset;
+    out.accumulator = accumulator;
+    out.timeScale = fastForward ? FAST_FORWARD_SCALE : 1.0f;
+    out.publishTime = std::chrono::steady_clock::now();
+    out.plannerNodes = plannerNodes;
+    out.plannerDepth = planner.depth;
+    out.autopilot = autopilot;
+    out.genomePlaying = genomePlaying;
+    out.inputSequence = inputSequence;
+    out.inputTime = inputTime;
+    out.simAllocations = threadAllocationCount() - replayAllocations - traceThreadAllocations();
+    snapshots.publish();
 }
 
-void DinoGame::update(float dt) {
-    updateGround();
-    updateDino();
-    updateDinoAnimation(dt);
-    updateCacti();
-    updatePteros(dt);
-    updateScore();
-    updateGameSpeed();
+// Fixed-rate loop on its own thread, so a slow present never holds up a tick
+void DinoGame::simulate() {
+    typedef FramePacer::Clock Clock;
+    if (!tracePath.empty()) {
+        traceThreadName("Simulation");
+    }
+    const Clock::duration tick = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(TICK_SECONDS));
+    
+    Clock::time_point last = Clock::now();
+    Clock::time_point next = last;
+    while (running.load(std::memory_order_acquire)) {
+        Clock::time_point now;
+        {
+            ScopedTimer timer(PROFILE_WAKEUP);
+            applyCommands();
+            
+            now = Clock::now();
+            update(std::chrono::duration<float>(now - last).count());
+            last = now;
+            publish();
+        }
+        
+        // Wake on the tick grid; after a stall start a fresh grid instead of bursting
+        next += tick;
+        if (next < now) next = now;
+        nextTickTime.store(next.time_since_epoch().count(), std::memory_order_release);
+        simPacer.waitUntil(next);
+    }
 }
 
-void DinoGame::render() {
+void DinoGame::render(const Snapshot& view) {
     window.clear(sf::Color::White);
     
-    window.draw(ground1);
-    window.draw(ground2);
+    interpolate(view);
     
-    for (const auto& cactus : cacti) {
-        window.draw(cactus);
+    // The atlas is packed once the last sprite is in
+    bool batched = batchedRendering && assets.complete();
+    {
+        ScopedTimer timer(PROFILE_BUILD);
+        if (batched) {
+            buildWorld(world, assets.atlas, pose);
+        } else {
+            sprites.update(pose);
+        }
+        updateText(view);
+        shownPlannerNodes = view.plannerNodes;
     }
     
-    for (const auto& ptero : pteros) {
-        if (ptero.active) {
-            window.draw(ptero.sprite);
+    {
+        ScopedTimer timer(PROFILE_DRAW);
+        if (batched) {
+            window.draw(world, &assets.atlas.getTexture());
+        } else {
+            sprites.draw(window, pose);
+        }
+        
+        scoreCounter.draw(window);
+        speedCounter.draw(window);
+        if (view.autopilot || view.genomePlaying) {
+            window.draw(botText.text);
+        }
+        if (lowLatency) {
+            window.draw(latencyText.text);
+        }
+        
+        if (view.sim.gameOver) {
+            window.draw(gameOverText);
+        }
+        
+        if (showProfiler) {
+            unsigned long long before = threadAllocationCount();
+            drawProfiler();
+            overlayAllocations += threadAllocationCount() - before;
         }
     }
     
-    window.draw(dino);
-    window.draw(scoreText);
-    window.draw(speedText);
+    {
+        ScopedTimer timer(PROFILE_DISPLAY);
+        window.display();
+    }
+    measureLatency(view);
+}
+
+// Per-stage table plus a bar per recent frame; red bars missed 60 Hz
+void DinoGame::drawProfiler() {
+    char table[1024] = "Stage (ms)      cur    avg    p99    max\n";
+    std::size_t length = std::strlen(table);
+    for (int stage = 0; stage < PROFILE_STAGE_COUNT; ++stage) {
+        StageStats stats = profileStats(static_cast<ProfileStage>(stage));
+        const char* indent = stage == PROFILE_FRAME || stage == PROFILE_WAKEUP ? "" : "  ";
+        length += std::snprintf(table + length, sizeof(table) - length, "%s%-*s %6.2f %6.2f %6.2f %6.2f\n", indent,
+                                13 - static_cast<int>(std::strlen(indent)), PROFILE_STAGE_NAMES[stage],
+                                stats.current / 1000, stats.average / 1000, stats.p99 / 1000, stats.max / 1000);
+    }
+    profileText.set(table);
+    
+    float frames[PROFILE_HISTORY];
+    int count = profileHistory(PROFILE_FRAME, frames);
     
-    if (gameOver) {
-        window.draw(gameOverText);
+    profileGraph.clear();
+    appendRect(profileGraph, PROFILER_X - 6, 0, WINDOW_WIDTH - PROFILER_X + 6,
+               PROFILER_GRAPH_Y + PROFILER_GRAPH_HEIGHT + 6, sf::Color(255, 255, 255, 220));
+    for (int i = 0; i < count; ++i) {
+        float height = std::min(frames[i] / PROFILER_GRAPH_MICROS, 1.0f) * PROFILER_GRAPH_HEIGHT;
+        sf::Color color = frames[i] > 1e6f / 60 + 500 ? sf::Color(220, 60, 60) : sf::Color(60, 160, 60);
+        appendRect(profileGraph, PROFILER_X + PROFILE_HISTORY - count + i,
+                   PROFILER_GRAPH_Y + PROFILER_GRAPH_HEIGHT - height, 1, height, color);
     }
+    appendRect(profileGraph, PROFILER_X, PROFILER_GRAPH_Y + PROFILER_GRAPH_HEIGHT / 2,
+               PROFILE_HISTORY, 1, sf::Color(90, 90, 90));
     
-    window.display();
+    window.draw(profileGraph);
+    window.draw(profileText.text);
 }
 
-void DinoGame::resetGame() {
-    dino.setTexture(dinoStandTexture);
-    dino.setPosition(100, WINDOW_HEIGHT - 12 - 45 + GROUND_OFFSET_Y);
-    dinoVelocity = 0;
-    isJumping = false;
-    isDucking = false;
-    cacti.clear();
-    score = 0;
-    groundOffset = 0;
-    gameOver = false;
-    dinoAnimationState = 0;
-    dinoAnimationTimer = 0;
-    obstacleSpeed = INITIAL_OBSTACLE_SPEED;
-    groundScrollSpeed = INITIAL_GROUND_SPEED;
-    gameTime = 0;
-    
-    for (auto& ptero : pteros) {
-        ptero.active = false;
-    }
-    
-    obstacleClock.restart();
-    pteroSpawnClock.restart();
-    scoreClock.restart();
-    dinoAnimationClock.restart();
-    gameTimeClock.restart();
+void DinoGame::resetGame(std::uint64_t seed) {
+    sim.reset(seed);
+    if (profilingMode.load(std::memory_order_relaxed) & PROFILE_TRACE) {
+        traceInstant("Reset", static_cast<long long>(seed));
+    }
+    previousDino = sim.dino;
+    previousGroundOffset = sim.groundOffset;
+    if (!playingReplay) {
+        replay.start(seed);
+    }
 }
 
-DinoGame::DinoGame() : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Dino Game") {
-    window.setFramerateLimit(60);
-    
-    // Load textures
-    if (!dinoStandTexture.loadFromFile("Dino-stand.png") ||
-        !dinoRightUpTexture.loadFromFile("Dino-right-up.png") ||
-        !dinoLeftUpTexture.loadFromFile("Dino-left-up.png") ||
-        !dinoBelowRightUpTexture.loadFromFile("Dino-below-right-up.png") ||
-        !dinoBelowLeftUpTexture.loadFromFile("Dino-below-left-up.png") ||
-        !dinoBigEyesTexture.loadFromFile("Dino-big-eyes.png") ||
-        !groundTexture.loadFromFile("ground.png") ||
-        !cactus1Texture.loadFromFile("Cactus-1.png") ||
-        !cactus2Texture.loadFromFile("Cactus-2.png") ||
-        !cactus3Texture.loadFromFile("Cactus-3.png") ||
-        !cactus4Texture.loadFromFile("Cactus-4.png") ||
-        !cactus5Texture.loadFromFile("Cactus-5.png") ||
-        !pteroDownTexture.loadFromFile("Ptero-down.png") ||
-        !pteroUpTexture.loadFromFile("Ptero-up.png")) {
-        std::cerr << "Failed to load textures!" << std::endl;
-        exit(1);
-    }
+// Render thread: uploads assets decoded since the last frame and hooks up
+// the sprites and text that were waiting for them
+// Returns false if an asset failed to load
+bool DinoGame::pollAssets() {
+    if (assets.complete() && textSet) return true;
     
-    if (!font.loadFromFile("arial.ttf")) {
-        font = sf::Font();
+    if (!assets.poll()) {
+        return false;
     }
-    
-    // Setup sprites
-    dino.setTexture(dinoStandTexture);
-    
-    ground1.setTexture(groundTexture);
-    ground2.setTexture(groundTexture);
-    
-    // Create pterodactyl pool
-    for (int i = 0; i < 5; ++i) {
-        pteros.emplace_back(pteroDownTexture, pteroUpTexture);
+    if (!groundSet && assets.ready(SPRITE_GROUND)) {
+        sprites.setGround();
+        groundSet = true;
+    }
+    if (!textSet && assets.fontReady()) {
+        setupText();
+        textSet = true;
     }
+    if (assets.complete() && !tracePath.empty()) {
+        traceComplete("Load assets", loadStart, FramePacer::Clock::now());
+    }
+    return true;
+}
+
+void DinoGame::setupText() {
+    scoreCounter.setup(assets.font, 24, sf::Color::Black, 10, 10, "Score: ");
+    speedCounter.setup(assets.font, 24, sf::Color::Black, 10, 40, "Speed: x");
+    shownScore = -1;
+    shownSpeedLevel = -1;
+    
+    botText.text.setFont(assets.font);
+    botText.text.setCharacterSize(18);
+    botText.text.setFillColor(sf::Color(90, 90, 90));
+    botText.text.setPosition(10, 70);
     
-    // Setup text
-    scoreText.setFont(font);
-    scoreText.setCharacterSize(24);
-    scoreText.setFillColor(sf::Color::Black);
-    scoreText.setPosition(10, 10);
+    latencyText.text.setFont(assets.font);
+    latencyText.text.setCharacterSize(18);
+    latencyText.text.setFillColor(sf::Color(90, 90, 90));
+    latencyText.text.setPosition(10, 95);
     
-    speedText.setFont(font);
-    speedText.setCharacterSize(24);
-    speedText.setFillColor(sf::Color::Black);
-    speedText.setPosition(10, 40);
+    profileText.text.setFont(assets.font);
+    profileText.text.setCharacterSize(12);
+    profileText.text.setFillColor(sf::Color::Black);
+    profileText.text.setPosition(PROFILER_X, 4);
     
-    gameOverText.setFont(font);
+    gameOverText.setFont(assets.font);
     gameOverText.setString("Game Over! Press SPACE to restart");
     gameOverText.setCharacterSize(30);
     gameOverText.setFillColor(sf::Color::Red);
     gameOverText.setPosition(WINDOW_WIDTH/2 - 200, WINDOW_HEIGHT/2 - 50);
+}
+
+// First frames: the ground line, a box where the dino will stand and a
+// progress bar, none of which need a loaded asset
+void DinoGame::drawLoading() {
+    window.clear(sf::Color::White);
+    
+    const DinoSim& sim = snapshots.front().sim;
+    const FrameSize& size = DINO_FRAME_SIZES[DINO_STAND];
+    placeholders.clear();
+    appendRect(placeholders, 0, WINDOW_HEIGHT - 12 + GROUND_OFFSET_Y, WINDOW_WIDTH, 2, PLACEHOLDER_COLOR);
+    appendRect(placeholders, sim.dino.x, sim.dino.y, size.width, size.height, PLACEHOLDER_COLOR);
+    appendRect(placeholders, WINDOW_WIDTH / 4, WINDOW_HEIGHT / 2, WINDOW_WIDTH / 2 * assets.progress(), 4, sf::Color(90, 90, 90));
+    window.draw(placeholders);
+    
+    window.display();
+}
+
+DinoGame::DinoGame(const GameOptions& options)
+    : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Dino Game"),
+      placeholders(sf::Quads), groundSet(false), textSet(false),
+      world(sf::Quads), batchedRendering(true), vsync(options.vsync), sprites(assets),
+      shownPlannerNodes(0), shownScore(-1), shownSpeedLevel(-1), shownLatencySamples(-1),
+      lowLatency(false), presentedInput(0),
+      latencySamples(0), latencySum(0), latencyMax(0),
+      showProfiler(false), profileGraph(sf::Quads), tracePath(options.tracePath),
+      allocCheck(options.allocCheck), frameCount(0), lastGameOver(false),
+      renderAllocations(0), overlayAllocations(0), simAllocations(0),
+      running(false), nextTickTime(0), sim(options.seed),
+      accumulator(0), fastForward(false),
+      recordPath(options.recordPath), playingReplay(!options.replayPath.empty()), replayCursor(0), replayAllocations(0),
+      autopilot(options.autopilot && !playingReplay), plannerNodes(0),
+      genomePlaying(false), genomeGeneration(-1), inputSequence(0) {
+    // Drawing no longer paces the game, so present at the display's rate or uncapped
+    setVsync(options.vsync);
+    setLowLatency(options.lowLatency);
+    
+    if (!tracePath.empty()) {
+        traceStart();
+        profilingMode.fetch_or(PROFILE_TRACE, std::memory_order_relaxed);
+        traceThreadName("Render");
+    }
+    
+    if (playingReplay && !replay.load(options.replayPath)) {
+        std::cerr << "Failed to load replay " << options.replayPath << std::endl;
+        exit(1);
+    }
+    
+    if (!options.genomePath.empty()) {
+        if (!loadGenome(options.genomePath, genome, &genomeGeneration)) {
+            std::cerr << "Failed to load genome " << options.genomePath << std::endl;
+            exit(1);
+        }
+        genomePlaying = !playingReplay;
+    }
+    
+    // Loose files keep decoding in the background while the window comes up.
+    // Started last, so the exits above never leave loader threads running.
+    loadStart = FramePacer::Clock::now();
+    if (!assets.start(options.bundlePath)) {
+        exit(1);
+    }
     
-    resetGame();
-    srand(time(nullptr));
+    resetGame(playingReplay ? replay.seed : options.seed);
+    publish();
 }
 
-void DinoGame::run() {
-    sf::Clock frameClock;
+int DinoGame::run() {
+    // Keep the window responsive until there is enough to play with
+    while (window.isOpen() && !assets.criticalReady()) {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                window.close();
+            }
+        }
+        // Nothing else runs yet; the loader threads are joined when assets is destroyed
+        if (!pollAssets()) return 1;
+        drawLoading();
+        std::this_thread::sleep_for(LOADING_FRAME_SLEEP);
+    }
+    
+    running.store(true, std::memory_order_release);
+    simThread = std::thread(&DinoGame::simulate, this);
+    
+    frameStart = FramePacer::Clock::now();
+    bool failed = false;
     while (window.isOpen()) {
-        float dt = frameClock.restart().asSeconds();
-        handleEvents();
-        update(dt);
-        render();
+        FramePacer::Clock::time_point now = FramePacer::Clock::now();
+        unsigned mode = profilingMode.load(std::memory_order_relaxed);
+        if (mode) {
+            profileSpan(PROFILE_FRAME, mode, frameStart, now);
+        }
+        frameStart = now;
+        
+        if (lowLatency) {
+            syncToTick();
+        } else {
+            handleEvents();
+            snapshots.update();
+        }
+        if (!pollAssets()) {
+            failed = true;
+            break;
+        }
+        render(snapshots.front());
+        checkAllocations(snapshots.front());
+    }
+    
+    running.store(false, std::memory_order_release);
+    simThread.join();
+    
+    if (!tracePath.empty()) {
+        long long events = traceWrite(tracePath);
+        if (events < 0) {
+            std::cerr << "Failed to write trace " << tracePath << std::endl;
+        } else {
+            std::cout << "Wrote " << events << " trace events to " << tracePath << std::endl;
+        }
+    }
+    
+    if (latencySamples > 0) {
+        std::cout << "Input to present: " << latencySamples << " inputs, avg "
+                  << latencySum / latencySamples << " ms, max " << latencyMax << " ms" << std::endl;
     }
+    return failed ? 1 : 0;
 }
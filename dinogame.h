@@ -2,77 +2,209 @@
 #define DINOGAME_H
 
 #include <SFML/Graphics.hpp>
-#include <vector>
-#include "pterodactyl.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include "assets.h"
+#include "dinosim.h"
+#include "genome.h"
+#include "hud.h"
+#include "pacer.h"
+#include "planner.h"
+#include "profiler.h"
+#include "replay.h"
+#include "scene.h"
+#include "spscqueue.h"
+#include "triplebuffer.h"
+
+struct GameOptions {
+    std::uint64_t seed;
+    std::string recordPath;    // save each finished game's replay here
+    std::string replayPath;    // play this replay instead of the keyboard
+    bool autopilot;            // start with the planner playing
+    std::string genomePath;    // let this trained policy play
+    bool vsync;                // false: present as fast as possible
+    bool lowLatency;           // poll input right before each tick and report latency
+    std::string tracePath;     // write a Chrome trace of the session here on exit
+    bool allocCheck;           // abort on any heap allocation in a steady-state frame
+    std::string bundlePath;    // packed assets; the loose files are used if missing
+};
+
+// Player input, forwarded from the render thread to the simulation thread
+enum GameCommand {
+    COMMAND_SPACE,
+    COMMAND_DUCK_PRESS,
+    COMMAND_DUCK_RELEASE,
+    COMMAND_SCRUB_BACK,
+    COMMAND_SCRUB_FORWARD,
+    COMMAND_FAST_FORWARD,
+    COMMAND_AUTOPILOT,
+    COMMAND_GENOME
+};
+
+// A command plus when the render thread polled it, for latency measurement
+struct InputEvent {
+    GameCommand command;
+    FramePacer::Clock::time_point time;
+};
+
+// Everything the render thread draws from, published once per simulation wakeup
+struct Snapshot {
+    DinoSim sim;
+    
+    // The tick before sim, and how far past sim the clock was when published,
+    // so frames between ticks can be drawn in between
+    Dino previousDino;
+    float previousGroundOffset;
+    float accumulator;
+    float timeScale;
+    std::chrono::steady_clock::time_point publishTime;
+    
+    long long plannerNodes;    // running total, the HUD shows the per-frame difference
+    int plannerDepth;
+    bool autopilot;
+    bool genomePlaying;
+    
+    // Newest input applied before this snapshot, counted and time-stamped
+    unsigned inputSequence;
+    FramePacer::Clock::time_point inputTime;
+    
+    // Sim-thread heap allocations so far, less those made saving or growing
+    // replays or recording the trace, for the allocation check
+    unsigned long long simAllocations;
+};
+
+const unsigned COMMAND_QUEUE_SIZE = 64;
 
 class DinoGame {
 private:
+    // Render thread: the window, assets and everything drawn
     sf::RenderWindow window;
     
-    // Textures
-    sf::Texture dinoStandTexture;
-    sf::Texture dinoRightUpTexture;
-    sf::Texture dinoLeftUpTexture;
-    sf::Texture dinoBelowRightUpTexture;
-    sf::Texture dinoBelowLeftUpTexture;
-    sf::Texture dinoBigEyesTexture;
-    sf::Texture groundTexture;
-    sf::Texture cactus1Texture;
-    sf::Texture cactus2Texture;
-    sf::Texture cactus3Texture;
-    sf::Texture cactus4Texture;
-    sf::Texture cactus5Texture;
-    sf::Texture pteroDownTexture;
-    sf::Texture pteroUpTexture;
-    
-    // Sprites
-    sf::Sprite dino;
-    sf::Sprite ground1;
-    sf::Sprite ground2;
-    std::vector<sf::Sprite> cacti;
-    std::vector<Pterodactyl> pteros;
-    
-    // Game variables
-    float dinoVelocity;
-    bool isJumping;
-    bool isDucking;
-    int score;
-    float groundOffset;
-    bool gameOver;
-    float dinoAnimationTimer;
-    int dinoAnimationState;
-    float obstacleSpeed;
-    float groundScrollSpeed;
-    float gameTime;
-    
-    // Text
-    sf::Font font;
-    sf::Text scoreText;
+    // Atlas for batched rendering, separate textures for the per-sprite path
+    Assets assets;
+    
+    // Assets still arriving: grey boxes stand in for missing sprites
+    sf::VertexArray placeholders;
+    bool groundSet;
+    bool textSet;
+    FramePacer::Clock::time_point loadStart;
+    
+    // Batched playfield
+    sf::VertexArray world;
+    bool batchedRendering;
+    bool vsync;
+    
+    // View of the latest snapshot moved to the current instant
+    DinoSim pose;
+    
+    // Per-sprite playfield, used until the atlas is packed
+    SpriteScene sprites;
+    
+    // Text. Score and speed are glyph quads rewritten only when they change.
+    HudCounter scoreCounter;
+    HudCounter speedCounter;
     sf::Text gameOverText;
-    sf::Text speedText;
-    
-    // Timers
-    sf::Clock obstacleClock;
-    sf::Clock pteroSpawnClock;
-    sf::Clock scoreClock;
-    sf::Clock dinoAnimationClock;
-    sf::Clock gameTimeClock;
-
+    HudText botText;
+    HudText latencyText;
+    long long shownPlannerNodes;
+    int shownScore;
+    int shownSpeedLevel;
+    int shownLatencySamples;
+    
+    // Low-latency mode: frames are phased to the simulation ticks
+    bool lowLatency;
+    FramePacer renderPacer;
+    unsigned presentedInput;
+    int latencySamples;
+    double latencySum;
+    double latencyMax;
+    
+    // Profiling overlay: per-stage times and a frame-time graph
+    bool showProfiler;
+    HudText profileText;
+    sf::VertexArray profileGraph;
+    FramePacer::Clock::time_point frameStart;
+    std::string tracePath;
+    
+    // Allocation check
+    bool allocCheck;
+    long long frameCount;
+    bool lastGameOver;
+    unsigned long long renderAllocations;     // render thread, less the overlay and trace
+    unsigned long long overlayAllocations;
+    unsigned long long simAllocations;        // as last published
+    
+    // Shared between the threads, lock-free
+    TripleBuffer<Snapshot> snapshots;
+    SpscQueue<InputEvent, COMMAND_QUEUE_SIZE> commands;
+    std::atomic<bool> running;
+    std::atomic<FramePacer::Clock::rep> nextTickTime;
+    std::thread simThread;
+    
+    // Simulation thread: the game and whatever drives it
+    DinoSim sim;
+    
+    // Fixed-timestep loop
+    FramePacer simPacer;
+    float accumulator;
+    bool fastForward;
+    Dino previousDino;
+    float previousGroundOffset;
+    
+    // Replay being recorded, or played back when playingReplay is set
+    Replay replay;
+    std::string recordPath;
+    bool playingReplay;
+    int replayCursor;
+    unsigned long long replayAllocations;
+    
+    // Search-based autopilot and the nodes it has expanded
+    Planner planner;
+    bool autopilot;
+    long long plannerNodes;
+    
+    // Trained policy loaded with --genome
+    Genome genome;
+    bool genomePlaying;
+    int genomeGeneration;
+    
+    unsigned inputSequence;
+    FramePacer::Clock::time_point inputTime;
+    
+    // Render thread
+    bool pollAssets();
+    void setupText();
+    void drawLoading();
     void handleEvents();
-    void updateGround();
-    void updateDino();
-    void updateDinoAnimation(float dt);
-    void updateCacti();
-    void updatePteros(float dt);
-    void updateScore();
-    void updateGameSpeed();
+    void sendCommand(GameCommand command);
+    void setVsync(bool enabled);
+    void setLowLatency(bool enabled);
+    void syncToTick();
+    void measureLatency(const Snapshot& view);
+    void drawProfiler();
+    void checkAllocations(const Snapshot& view);
+    void interpolate(const Snapshot& view);
+    void updateText(const Snapshot& view);
+    void render(const Snapshot& view);
+    
+    // Simulation thread
+    void simulate();
+    void applyCommands();
+    void applyInput(int type);
+    void applyBotAction(int action);
+    void seekReplay(int tick);
     void update(float dt);
-    void render();
-    void resetGame();
+    void traceStep(unsigned pushesBefore, int levelBefore);
+    void publish();
+    void resetGame(std::uint64_t seed);
     
 public:
-    DinoGame();
-    void run();
+    explicit DinoGame(const GameOptions& options);
+    // Returns the process exit code
+    int run();
 };
 
 #endif // DINOGAME_H
@@ -0,0 +1,300 @@
+#include "dinosim.h"
+#include <algorithm>
+#include <cmath>
+#include "collision.h"
+
+static void moveDino(Dino& dino) {
+    dino.velocity += GRAVITY;
+    dino.y += dino.velocity;
+
+    float groundLevel = WINDOW_HEIGHT - 7 - (dino.isDucking ? 28 : 45) + GROUND_OFFSET_Y;
+    if (dino.y >= groundLevel) {
+        dino.y = groundLevel;
+        dino.velocity = 0;
+        dino.isJumping = false;
+    }
+}
+
+static void animateDino(Dino& dino) {
+    if (++dino.animationTicks >= DINO_ANIMATION_TICKS) {
+        dino.animationTicks = 0;
+
+        if (dino.isDucking) {
+            dino.animationState = (dino.animationState + 1) % 2;
+            dino.frame = dino.animationState == 0 ? DINO_BELOW_RIGHT_UP : DINO_BELOW_LEFT_UP;
+        }
+        else if (!dino.isJumping) {
+            dino.animationState = (dino.animationState + 1) % 3;
+
+            switch (dino.animationState) {
+                case 0: dino.frame = DINO_STAND; break;
+                case 1: dino.frame = DINO_RIGHT_UP; break;
+                case 2: dino.frame = DINO_LEFT_UP; break;
+            }
+        } else {
+            dino.frame = DINO_STAND;
+        }
+    }
+}
+
+static void animateObstacle(Obstacle& obstacle, int ticks) {
+    if (obstacle.kind != OBSTACLE_PTERO) return;
+
+    int total = obstacle.animationTicks + ticks;
+    obstacle.animationTicks = total % PTERO_ANIMATION_TICKS;
+    obstacle.frame ^= (total / PTERO_ANIMATION_TICKS) & 1;
+}
+
+// Bounding boxes first, then the alpha masks at whole-pixel offsets
+static bool overlaps(const Dino& dino, const Obstacle& obstacle) {
+    const FrameSize& size = DINO_FRAME_SIZES[dino.frame];
+    if (!(dino.x < obstacle.x + obstacle.width && obstacle.x < dino.x + size.width &&
+          dino.y < obstacle.y + obstacle.height && obstacle.y < dino.y + size.height)) {
+        return false;
+    }
+
+    const HitMask& mask = obstacle.kind == OBSTACLE_CACTUS ? CACTUS_MASKS[obstacle.type]
+                                                           : PTERO_MASKS[obstacle.frame];
+    int dx = static_cast<int>(std::lround(obstacle.x - dino.x));
+    int dy = static_cast<int>(std::lround(obstacle.y - dino.y));
+    return masksOverlap(DINO_MASKS[dino.frame], mask, dx, dy);
+}
+
+template <int Capacity>
+BasicDinoSim<Capacity>::BasicDinoSim(std::uint64_t seed, const SimSettings& settings) {
+    this->settings = settings;
+    reset(seed);
+}
+
+template <int Capacity>
+void BasicDinoSim<Capacity>::reset(std::uint64_t seed) {
+    dino.x = DINO_START_X;
+    dino.y = WINDOW_HEIGHT - 12 - 45 + GROUND_OFFSET_Y;
+    dino.velocity = 0;
+    dino.isJumping = false;
+    dino.isDucking = false;
+    dino.animationTicks = 0;
+    dino.animationState = 0;
+    dino.frame = DINO_STAND;
+
+    obstacles.clear();
+    obstacles.setLimit(settings.obstacleLimit);
+    activePteros = 0;
+
+    score = 0;
+    groundOffset = 0;
+    gameOver = false;
+    invincible = false;
+    obstacleSpeed = INITIAL_OBSTACLE_SPEED;
+    groundScrollSpeed = INITIAL_GROUND_SPEED;
+    gameTicks = 0;
+
+    obstacleTicks = 0;
+    pteroSpawnTicks = 0;
+    scoreTicks = 0;
+
+    this->seed = seed;
+    rng.seed(seed);
+}
+
+template <int Capacity>
+void BasicDinoSim<Capacity>::jump() {
+    if (!dino.isJumping && !gameOver) {
+        dino.velocity = JUMP_FORCE;
+        dino.isJumping = true;
+    }
+}
+
+template <int Capacity>
+void BasicDinoSim<Capacity>::setDucking(bool ducking) {
+    dino.isDucking = ducking;
+}
+
+template <int Capacity>
+int BasicDinoSim<Capacity>::speedLevel() const {
+    return gameTicks / SPEED_INCREASE_TICKS;
+}
+
+template <int Capacity>
+bool BasicDinoSim<Capacity>::rollCactus(Obstacle& cactus) {
+    if (rng.below(100) >= settings.cactusChance) return false;
+
+    cactus = Obstacle();
+    cactus.kind = OBSTACLE_CACTUS;
+    cactus.type = rng.below(CACTUS_TYPES);
+    cactus.width = CACTUS_SIZES[cactus.type].width;
+    cactus.height = CACTUS_SIZES[cactus.type].height;
+    cactus.x = settings.spawnX;
+    cactus.y = WINDOW_HEIGHT - 7 - cactus.height + GROUND_OFFSET_Y;
+    cactus.alive = true;
+    return true;
+}
+
+template <int Capacity>
+bool BasicDinoSim<Capacity>::rollPtero(Obstacle& ptero) {
+    if (rng.below(100) >= settings.pteroChance) return false;
+
+    float height = WINDOW_HEIGHT - 12 - 50 + GROUND_OFFSET_Y - rng.below(100);
+    ptero = Obstacle();
+    ptero.kind = OBSTACLE_PTERO;
+    ptero.width = PTERO_SIZE.width;
+    ptero.height = PTERO_SIZE.height;
+    ptero.x = settings.spawnX;
+    ptero.y = height + 25;
+    ptero.alive = true;
+    return true;
+}
+
+// Swept test of an obstacle that is at startX before sub-tick 0 and moves
+// left by obstacleSpeed every sub-tick. Every sub-tick whose x range can
+// overlap the dino is tested at its end position, exactly as single-tick
+// stepping would, so a coarse step finds the same hits. Like single ticks, it
+// does not look between tick positions.
+// Returns the first colliding sub-tick in [from, to], or to + 1.
+template <int Capacity>
+int BasicDinoSim<Capacity>::firstHit(const Obstacle& obstacle, float startX, int from, int to, const Dino* path) const {
+    float enter = (startX - dino.x - DINO_MAX_WIDTH) / obstacleSpeed;
+    float leave = (startX + obstacle.width - dino.x) / obstacleSpeed;
+    int first = std::max(from, static_cast<int>(std::floor(enter)));
+    int last = std::min(to, static_cast<int>(std::ceil(leave)));
+
+    for (int tick = first; tick <= last; ++tick) {
+        Obstacle at = obstacle;
+        at.x = startX - tick * obstacleSpeed;
+        animateObstacle(at, tick - from + 1);
+        if (overlaps(path[tick], at)) return tick;
+    }
+    return to + 1;
+}
+
+template <int Capacity>
+void BasicDinoSim<Capacity>::moveObstacle(Obstacle& obstacle, float startX, int ticks) {
+    obstacle.x = startX - ticks * obstacleSpeed;
+
+    float despawnX = obstacle.kind == OBSTACLE_PTERO ? -100 : -50;
+    if (obstacle.x < despawnX) {
+        obstacle.alive = false;
+        if (obstacle.kind == OBSTACLE_PTERO) {
+            activePteros--;
+        }
+    }
+}
+
+template <int Capacity>
+void BasicDinoSim<Capacity>::step() {
+    advance(1);
+}
+
+// Advances up to MAX_STEP_TICKS ticks at once with the same per-tick rules:
+// ground, dino, cactus spawn, obstacle motion and collision, bird spawn,
+// score and speed. The dino is integrated tick by tick (it is cheap), while
+// obstacles move once and are swept against its path. A step stops early at
+// a collision or a speed-level change; returns the ticks actually simulated.
+template <int Capacity>
+int BasicDinoSim<Capacity>::advance(int ticks) {
+    if (gameOver) return 0;
+    ticks = std::max(1, std::min(ticks, MAX_STEP_TICKS));
+    ticks = std::min(ticks, SPEED_INCREASE_TICKS - gameTicks % SPEED_INCREASE_TICKS);
+    // At most one spawn of each kind per step
+    ticks = std::min(ticks, std::min(settings.cactusSpawnTicks, settings.pteroSpawnTicks));
+
+    Dino path[MAX_STEP_TICKS + 1];
+    path[0] = dino;
+    for (int tick = 1; tick <= ticks; ++tick) {
+        path[tick] = path[tick - 1];
+        moveDino(path[tick]);
+        animateDino(path[tick]);
+    }
+
+    // Spawns falling inside the step, rolled in tick order. A cactus moves on
+    // its spawn tick, a bird spawns after the move and only moves from the next.
+    int cactusTick = settings.cactusSpawnTicks - obstacleTicks;
+    int pteroTick = settings.pteroSpawnTicks - pteroSpawnTicks;
+    Obstacle cactus, ptero;
+    bool cactusSpawned = false;
+    bool pteroSpawned = false;
+    if (cactusTick <= ticks && cactusTick <= pteroTick) cactusSpawned = rollCactus(cactus);
+    if (pteroTick <= ticks && rollPtero(ptero)) {
+        // The bird needs a free pool slot at its spawn tick; the hit test and
+        // the commit below both go by this
+        int flying = activePteros;
+        for (int i = 0; i < obstacles.size(); ++i) {
+            const Obstacle& obstacle = obstacles[i];
+            if (obstacle.alive && obstacle.kind == OBSTACLE_PTERO && obstacle.x - pteroTick * obstacleSpeed < -100) {
+                flying--;
+            }
+        }
+        pteroSpawned = flying < settings.pteroLimit;
+    }
+    if (cactusTick <= ticks && cactusTick > pteroTick) cactusSpawned = rollCactus(cactus);
+    float cactusStartX = settings.spawnX + (cactusTick - 1) * obstacleSpeed;
+    float pteroStartX = settings.spawnX + pteroTick * obstacleSpeed;
+
+    int hitTick = ticks + 1;
+    for (int i = 0; i < obstacles.size(); ++i) {
+        const Obstacle& obstacle = obstacles[i];
+        if (obstacle.alive) {
+            hitTick = std::min(hitTick, firstHit(obstacle, obstacle.x, 1, ticks, path));
+        }
+    }
+    if (cactusSpawned) {
+        hitTick = std::min(hitTick, firstHit(cactus, cactusStartX, cactusTick, ticks, path));
+    }
+    if (pteroSpawned && pteroTick < ticks) {
+        hitTick = std::min(hitTick, firstHit(ptero, pteroStartX, pteroTick + 1, ticks, path));
+    }
+
+    // Commit up to and including the colliding tick
+    bool hit = hitTick <= ticks && !invincible;
+    int done = hit ? hitTick : ticks;
+    int full = hit ? done - 1 : done;    // ticks that also reached bird spawn, score and speed
+
+    dino = path[done];
+    for (int tick = 0; tick < done; ++tick) {
+        groundOffset += groundScrollSpeed;
+        if (groundOffset > 1200) {
+            groundOffset = 0;
+        }
+    }
+
+    for (int i = 0; i < obstacles.size(); ++i) {
+        Obstacle& obstacle = obstacles[i];
+        if (obstacle.alive) {
+            animateObstacle(obstacle, done);
+            moveObstacle(obstacle, obstacle.x, done);
+        }
+    }
+    if (cactusSpawned && cactusTick <= done) {
+        moveObstacle(cactus, cactusStartX, done);
+        obstacles.push(cactus);
+    }
+    if (pteroSpawned && pteroTick <= full) {
+        animateObstacle(ptero, done - pteroTick);
+        moveObstacle(ptero, pteroStartX, done);
+        if (obstacles.push(ptero)) {
+            activePteros++;
+        }
+    }
+    obstacles.popDead();
+
+    obstacleTicks = (obstacleTicks + done) % settings.cactusSpawnTicks;
+    pteroSpawnTicks = (pteroSpawnTicks + full) % settings.pteroSpawnTicks;
+
+    scoreTicks += full;
+    score += scoreTicks / SCORE_TICKS;
+    scoreTicks %= SCORE_TICKS;
+
+    gameTicks += full;
+    int level = speedLevel();
+    obstacleSpeed = INITIAL_OBSTACLE_SPEED + level * SPEED_INCREASE_FACTOR;
+    groundScrollSpeed = INITIAL_GROUND_SPEED + level * SPEED_INCREASE_FACTOR;
+
+    if (hit) {
+        gameOver = true;
+        dino.frame = DINO_BIG_EYES;
+    }
+    return done;
+}
+
+template class BasicDinoSim<MAX_OBSTACLES>;
+template class BasicDinoSim<WIDE_MAX_OBSTACLES>;
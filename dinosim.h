@@ -0,0 +1,178 @@
+#ifndef DINOSIM_H
+#define DINOSIM_H
+
+#include <cstdint>
+#include <type_traits>
+#include "obstacles.h"
+#include "rng.h"
+
+const int WINDOW_WIDTH = 800;
+const int WINDOW_HEIGHT = 300;
+const float GRAVITY = 0.5f;
+const float JUMP_FORCE = -12.0f;
+const float INITIAL_OBSTACLE_SPEED = 5.0f;
+const float INITIAL_GROUND_SPEED = 4.0f;
+const int GROUND_OFFSET_Y = -10;
+const float SPEED_INCREASE_FACTOR = 0.2f;
+
+const float DINO_START_X = 100;
+const int PTERO_POOL_SIZE = 5;
+const float PTERO_SCALE = 0.5f;
+
+// The simulation advances in fixed ticks; every timer below is counted in ticks
+const int TICKS_PER_SECOND = 60;
+const float TICK_SECONDS = 1.0f / TICKS_PER_SECOND;
+const int DINO_ANIMATION_TICKS = 9;      // 0.15 s
+const int PTERO_ANIMATION_TICKS = 12;    // 0.2 s
+const int PTERO_SPAWN_TICKS = 300;       // 5 s
+const int CACTUS_SPAWN_TICKS = 90;       // 1.5 s
+const int SCORE_TICKS = 6;               // 0.1 s
+const int SPEED_INCREASE_TICKS = 1800;   // 30 s
+const int MAX_STEP_TICKS = 60;           // longest single advance()
+
+// Frame sizes of the PNGs, so the simulation can size hitboxes without loading them
+enum DinoFrame {
+    DINO_STAND,
+    DINO_RIGHT_UP,
+    DINO_LEFT_UP,
+    DINO_BELOW_RIGHT_UP,
+    DINO_BELOW_LEFT_UP,
+    DINO_BIG_EYES,
+    DINO_FRAME_COUNT
+};
+
+const int CACTUS_TYPES = 5;
+
+struct FrameSize {
+    float width;
+    float height;
+};
+
+const FrameSize DINO_FRAME_SIZES[DINO_FRAME_COUNT] = {
+    {42, 45}, {42, 45}, {42, 45}, {57, 28}, {57, 28}, {42, 45}
+};
+const FrameSize CACTUS_SIZES[CACTUS_TYPES] = {
+    {25, 48}, {17, 35}, {51, 49}, {49, 49}, {34, 35}
+};
+const FrameSize PTERO_SIZE = {100 * PTERO_SCALE, 100 * PTERO_SCALE};
+const float DINO_MAX_WIDTH = 57;
+
+struct Dino {
+    float x;
+    float y;
+    float velocity;
+    bool isJumping;
+    bool isDucking;
+    int animationTicks;
+    int animationState;
+    DinoFrame frame;
+};
+
+// What a game is played with. DEFAULT_SIM_SETTINGS is the real game; stress
+// runs widen the world and spawn far more often through the same rules.
+struct SimSettings {
+    int cactusSpawnTicks;     // a cactus is rolled this often
+    int cactusChance;         // percent
+    int pteroSpawnTicks;
+    int pteroChance;
+    int pteroLimit;           // birds alive at once
+    int obstacleLimit;        // obstacles alive at once, capped by the ring; spawns beyond are dropped
+    float spawnX;             // obstacles enter here and scroll off the left edge
+};
+
+const SimSettings DEFAULT_SIM_SETTINGS = {
+    CACTUS_SPAWN_TICKS, 30, PTERO_SPAWN_TICKS, 20, PTERO_POOL_SIZE, MAX_OBSTACLES, WINDOW_WIDTH
+};
+
+// Everything a game is made of, as plain data. Copying it forks the game,
+// random stream included, so snapshot/restore is a single memcpy.
+template <int Capacity>
+struct BasicSimState {
+    Dino dino;
+
+    // Cacti and pterodactyls in spawn order
+    BasicObstacleRing<Capacity> obstacles;
+    int activePteros;
+
+    // Game variables
+    int score;
+    float groundOffset;
+    bool gameOver;
+    bool invincible;          // collisions are detected but never end the game
+    float obstacleSpeed;
+    float groundScrollSpeed;
+    int gameTicks;
+
+    // Timers
+    int obstacleTicks;
+    int pteroSpawnTicks;
+    int scoreTicks;
+
+    SimSettings settings;
+
+    // Randomness
+    std::uint64_t seed;
+    Rng rng;
+};
+
+typedef BasicSimState<MAX_OBSTACLES> SimState;
+
+static_assert(std::is_trivially_copyable<SimState>::value, "SimState must stay memcpy-able");
+
+// Game rules without any SFML dependency: DinoGame renders from this,
+// headless tools step it directly. Capacity bounds the obstacles alive at
+// once: the game keeps a screenful, stress runs a whole wide world.
+template <int Capacity>
+class BasicDinoSim : public BasicSimState<Capacity> {
+public:
+    typedef BasicSimState<Capacity> State;
+    using State::dino;
+    using State::obstacles;
+    using State::activePteros;
+    using State::score;
+    using State::groundOffset;
+    using State::gameOver;
+    using State::invincible;
+    using State::obstacleSpeed;
+    using State::groundScrollSpeed;
+    using State::gameTicks;
+    using State::obstacleTicks;
+    using State::pteroSpawnTicks;
+    using State::scoreTicks;
+    using State::settings;
+    using State::seed;
+    using State::rng;
+
+    // Settings persist across reset()
+    explicit BasicDinoSim(std::uint64_t seed = 0, const SimSettings& settings = DEFAULT_SIM_SETTINGS);
+    void reset(std::uint64_t seed);
+    void jump();
+    void setDucking(bool ducking);
+    void step();
+    int advance(int ticks);
+    int speedLevel() const;
+
+    State snapshot() const {
+        return *this;
+    }
+
+    void restore(const State& state) {
+        static_cast<State&>(*this) = state;
+    }
+
+private:
+    bool rollCactus(Obstacle& cactus);
+    bool rollPtero(Obstacle& ptero);
+    int firstHit(const Obstacle& obstacle, float startX, int from, int to, const Dino* path) const;
+    void moveObstacle(Obstacle& obstacle, float startX, int ticks);
+};
+
+const int WIDE_MAX_OBSTACLES = 1 << 14;
+
+typedef BasicDinoSim<MAX_OBSTACLES> DinoSim;
+typedef BasicDinoSim<WIDE_MAX_OBSTACLES> WideDinoSim;    // about 400 KB of obstacles
+
+extern template class BasicDinoSim<MAX_OBSTACLES>;
+extern template class BasicDinoSim<WIDE_MAX_OBSTACLES>;
+
+#endif // DINOSIM_H
@@ -0,0 +1,129 @@
+// Throughput of the obstacle update at stress-test scale: the per-object
+// array-of-structs loop DinoSim uses versus ObstacleField's SIMD columns.
+//   g++ -std=c++17 -O2 -march=native fieldbench.cpp obstaclefield.cpp dinosim.cpp collision.cpp hitmasks.cpp -o fieldbench
+//   ./fieldbench --obstacles 16384 --ticks 2000
+#include "dinosim.h"
+#include "obstaclefield.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+const int DEFAULT_OBSTACLES = 16384;
+const int DEFAULT_TICKS = 2000;
+const float SPAWN_SPACING = 8;    // pixels of world per obstacle, keeps density constant
+
+static Obstacle spawn(Rng& rng, float worldWidth) {
+    Obstacle obstacle = Obstacle();
+    obstacle.kind = rng.below(4) == 0 ? OBSTACLE_PTERO : OBSTACLE_CACTUS;
+    if (obstacle.kind == OBSTACLE_PTERO) {
+        obstacle.width = PTERO_SIZE.width;
+        obstacle.height = PTERO_SIZE.height;
+        obstacle.y = WINDOW_HEIGHT - 12 - 50 + GROUND_OFFSET_Y - rng.below(100) + 25;
+    } else {
+        obstacle.type = rng.below(CACTUS_TYPES);
+        obstacle.width = CACTUS_SIZES[obstacle.type].width;
+        obstacle.height = CACTUS_SIZES[obstacle.type].height;
+        obstacle.y = WINDOW_HEIGHT - 7 - obstacle.height + GROUND_OFFSET_Y;
+    }
+    obstacle.x = static_cast<float>(rng.below(static_cast<int>(worldWidth)));
+    obstacle.alive = 1;
+    return obstacle;
+}
+
+// What DinoSim does per obstacle, one object at a time
+static long long runObjects(int count, int ticks, float worldWidth, double& seconds) {
+    Rng rng;
+    rng.seed(1);
+    std::vector<Obstacle> obstacles;
+    for (int i = 0; i < count; ++i) {
+        obstacles.push_back(spawn(rng, worldWidth));
+    }
+    
+    Dino dino = DinoSim().dino;
+    const FrameSize& size = DINO_FRAME_SIZES[dino.frame];
+    long long hits = 0;
+    std::vector<int> culled;
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; ++tick) {
+        culled.clear();
+        for (int i = 0; i < static_cast<int>(obstacles.size()); ++i) {
+            Obstacle& obstacle = obstacles[i];
+            obstacle.x -= INITIAL_OBSTACLE_SPEED;
+            int total = obstacle.animationTicks + 1;
+            obstacle.animationTicks = total % PTERO_ANIMATION_TICKS;
+            obstacle.frame ^= (total / PTERO_ANIMATION_TICKS) & 1;
+            if (obstacle.x < (obstacle.kind == OBSTACLE_PTERO ? -100 : -50)) {
+                culled.push_back(i);
+            }
+            else if (dino.x < obstacle.x + obstacle.width && obstacle.x < dino.x + size.width &&
+                     dino.y < obstacle.y + obstacle.height && obstacle.y < dino.y + size.height) {
+                hits++;
+            }
+        }
+        for (int k = static_cast<int>(culled.size()) - 1; k >= 0; --k) {
+            obstacles[culled[k]] = obstacles.back();
+            obstacles.pop_back();
+        }
+        while (static_cast<int>(obstacles.size()) < count) {
+            Obstacle obstacle = spawn(rng, worldWidth);
+            obstacle.x += worldWidth;
+            obstacles.push_back(obstacle);
+        }
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return hits;
+}
+
+static long long runField(int count, int ticks, float worldWidth, double& seconds) {
+    Rng rng;
+    rng.seed(1);
+    ObstacleField field(count);
+    for (int i = 0; i < count; ++i) {
+        field.add(spawn(rng, worldWidth));
+    }
+    
+    Dino dino = DinoSim().dino;
+    const FrameSize& size = DINO_FRAME_SIZES[dino.frame];
+    std::vector<int> candidates(field.capacity());
+    long long hits = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; ++tick) {
+        field.advance(INITIAL_OBSTACLE_SPEED, 1);
+        hits += field.overlapping(dino.x, dino.y, size.width, size.height, candidates.data());
+        while (field.size() < count) {
+            Obstacle obstacle = spawn(rng, worldWidth);
+            obstacle.x += worldWidth;
+            field.add(obstacle);
+        }
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return hits;
+}
+
+int main(int argc, char* argv[]) {
+    int count = DEFAULT_OBSTACLES;
+    int ticks = DEFAULT_TICKS;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--obstacles") == 0) count = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--ticks") == 0) ticks = std::atoi(argv[i + 1]);
+        else {
+            std::cerr << "Usage: fieldbench [--obstacles N] [--ticks N]" << std::endl;
+            return 1;
+        }
+    }
+    
+    float worldWidth = count * SPAWN_SPACING;
+    double objectSeconds = 0, fieldSeconds = 0;
+    long long objectHits = runObjects(count, ticks, worldWidth, objectSeconds);
+    long long fieldHits = runField(count, ticks, worldWidth, fieldSeconds);
+    
+    double updates = static_cast<double>(count) * ticks;
+    std::cout << count << " obstacles, " << ticks << " ticks" << std::endl;
+    std::cout << "Per object:   " << updates / objectSeconds / 1e6 << " M obstacle-ticks/s ("
+              << objectSeconds * 1e6 / ticks << " us/tick), " << objectHits << " overlaps" << std::endl;
+    std::cout << "SoA columns:  " << updates / fieldSeconds / 1e6 << " M obstacle-ticks/s ("
+              << fieldSeconds * 1e6 / ticks << " us/tick), " << fieldHits << " overlaps" << std::endl;
+    return objectHits == fieldHits ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+#include "genome.h"
+#include <algorithm>
+#include <fstream>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+const char GENOME_MAGIC[4] = {'D', 'G', 'N', 'M'};
+const std::uint32_t GENOME_VERSION = 1;
+
+// out = bias + sum over i of in[i] * weights[i]; outCount is a multiple of 4
+static void dense(const float* in, int inCount, const float* weights, const float* bias,
+                  float* out, int outCount) {
+    int o = 0;
+#if defined(__AVX__)
+    for (; o + 8 <= outCount; o += 8) {
+        __m256 sum = _mm256_loadu_ps(bias + o);
+        for (int i = 0; i < inCount; ++i) {
+            __m256 row = _mm256_loadu_ps(weights + i * outCount + o);
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(in[i]), row));
+        }
+        _mm256_storeu_ps(out + o, sum);
+    }
+#endif
+#if defined(__SSE__)
+    for (; o + 4 <= outCount; o += 4) {
+        __m128 sum = _mm_loadu_ps(bias + o);
+        for (int i = 0; i < inCount; ++i) {
+            __m128 row = _mm_loadu_ps(weights + i * outCount + o);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(in[i]), row));
+        }
+        _mm_storeu_ps(out + o, sum);
+    }
+#elif defined(__ARM_NEON)
+    for (; o + 4 <= outCount; o += 4) {
+        float32x4_t sum = vld1q_f32(bias + o);
+        for (int i = 0; i < inCount; ++i) {
+            sum = vmlaq_n_f32(sum, vld1q_f32(weights + i * outCount + o), in[i]);
+        }
+        vst1q_f32(out + o, sum);
+    }
+#endif
+    for (; o < outCount; ++o) {
+        float sum = bias[o];
+        for (int i = 0; i < inCount; ++i) {
+            sum += in[i] * weights[i * outCount + o];
+        }
+        out[o] = sum;
+    }
+}
+
+int genomeAction(const Genome& genome, const float* obs) {
+    const float* w = genome.weights;
+    float hidden[NET_HIDDEN];
+    float scores[NET_OUTPUTS];
+
+    dense(obs, NET_INPUTS, w + GENOME_HIDDEN_WEIGHTS, w + GENOME_HIDDEN_BIAS, hidden, NET_HIDDEN);
+    for (float& unit : hidden) {
+        unit = unit > 0 ? unit : 0;
+    }
+    dense(hidden, NET_HIDDEN, w + GENOME_OUTPUT_WEIGHTS, w + GENOME_OUTPUT_BIAS, scores, NET_OUTPUTS);
+
+    int best = 0;
+    for (int action = 1; action < ACTION_COUNT; ++action) {
+        if (scores[action] > scores[best]) best = action;
+    }
+    return best;
+}
+
+bool saveGenome(const std::string& path, const Genome& genome, int generation, float fitness) {
+    std::ofstream file(path, std::ios::binary);
+    std::uint32_t header[] = {GENOME_VERSION, static_cast<std::uint32_t>(GENOME_SIZE),
+                              static_cast<std::uint32_t>(generation)};
+    file.write(GENOME_MAGIC, sizeof(GENOME_MAGIC));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(&fitness), sizeof(fitness));
+    file.write(reinterpret_cast<const char*>(genome.weights), sizeof(genome.weights));
+    return static_cast<bool>(file);
+}
+
+bool loadGenome(const std::string& path, Genome& genome, int* generation, float* fitness) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[4];
+    std::uint32_t header[3];
+    float savedFitness;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    file.read(reinterpret_cast<char*>(&savedFitness), sizeof(savedFitness));
+    if (!file || !std::equal(magic, magic + 4, GENOME_MAGIC) ||
+        header[0] != GENOME_VERSION || header[1] != static_cast<std::uint32_t>(GENOME_SIZE)) {
+        return false;
+    }
+
+    Genome loaded;
+    file.read(reinterpret_cast<char*>(loaded.weights), sizeof(loaded.weights));
+    if (!file) return false;
+
+    genome = loaded;
+    if (generation) *generation = static_cast<int>(header[2]);
+    if (fitness) *fitness = savedFitness;
+    return true;
+}
@@ -0,0 +1,35 @@
+#ifndef GENOME_H
+#define GENOME_H
+
+#include <cstdint>
+#include <string>
+#include "vecenv.h"
+
+// Fixed topology: OBS_SIZE inputs -> NET_HIDDEN ReLU units -> one score per
+// action. Layer widths are multiples of 4 so every row is whole SIMD vectors;
+// the last output lane is padding and never chosen.
+const int NET_INPUTS = OBS_SIZE;
+const int NET_HIDDEN = 16;
+const int NET_OUTPUTS = 4;
+
+// Offsets into Genome::weights. Weight matrices are input-major: row i holds
+// what input i adds to every unit of the next layer.
+const int GENOME_HIDDEN_WEIGHTS = 0;
+const int GENOME_HIDDEN_BIAS = GENOME_HIDDEN_WEIGHTS + NET_INPUTS * NET_HIDDEN;
+const int GENOME_OUTPUT_WEIGHTS = GENOME_HIDDEN_BIAS + NET_HIDDEN;
+const int GENOME_OUTPUT_BIAS = GENOME_OUTPUT_WEIGHTS + NET_HIDDEN * NET_OUTPUTS;
+const int GENOME_SIZE = GENOME_OUTPUT_BIAS + NET_OUTPUTS;
+
+// A policy is just its weights, so genomes copy and mutate as flat arrays
+struct Genome {
+    alignas(32) float weights[GENOME_SIZE];
+};
+
+// Forward pass on one observation; returns an Action. No allocation.
+int genomeAction(const Genome& genome, const float* obs);
+
+// Checkpoint: genome plus the generation and fitness it was saved at
+bool saveGenome(const std::string& path, const Genome& genome, int generation, float fitness);
+bool loadGenome(const std::string& path, Genome& genome, int* generation = nullptr, float* fitness = nullptr);
+
+#endif // GENOME_H
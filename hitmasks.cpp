@@ -0,0 +1,207 @@
+// Generated by maskgen.cpp from the sprite PNGs. Do not edit.
+#include "collision.h"
+
+static const std::uint64_t DINO_STAND_ROWS[45] = {
+    0x0000000000000000ULL, 0x0000007fff800000ULL, 0x0000007fff800000ULL, 0x000001ffffe00000ULL,
+    0x000001fff9e00000ULL, 0x000001fff9e00000ULL, 0x000001ffffe00000ULL, 0x000001ffffe00000ULL,
+    0x000001ffffe00000ULL, 0x000001ffffe00000ULL, 0x000001ffffe00000ULL, 0x000001ffffe00000ULL,
+    0x000000007fe00000ULL, 0x000000007fe00000ULL, 0x0000001fffe00000ULL, 0x0000001fffe00000ULL,
+    0x000000001ff80006ULL, 0x000000001ff80006ULL, 0x000000001fff0006ULL, 0x000000001fff0006ULL,
+    0x00000001ffffe01eULL, 0x00000001ffffe01eULL, 0x000000019ffff87eULL, 0x000000019ffff87eULL,
+    0x000000001ffffffeULL, 0x000000001ffffffeULL, 0x000000001ffffffeULL, 0x000000001ffffffeULL,
+    0x000000001ffffff8ULL, 0x0000000007fffff8ULL, 0x0000000007ffffe0ULL, 0x0000000007ffffe0ULL,
+    0x0000000001ffff80ULL, 0x0000000001ffff80ULL, 0x00000000007ffe00ULL, 0x00000000007ffe00ULL,
+    0x000000000079f800ULL, 0x000000000079f800ULL, 0x0000000000607800ULL, 0x0000000000607800ULL,
+    0x0000000000601800ULL, 0x0000000000601800ULL, 0x0000000001e07800ULL, 0x0000000001e07800ULL,
+    0x0000000000000000ULL
+};
+
+static const std::uint64_t DINO_RIGHT_UP_ROWS[45] = {
+    0x0000000000000000ULL, 0x0000007fff800000ULL, 0x0000007fff800000ULL, 0x000001ffffe00000ULL,
+    0x000001fff9e00000ULL, 0x000001fff9e00000ULL, 0x000001ffffe00000ULL, 0x000001ffffe00000ULL,
+    0x000001ffffe00000ULL, 0x000001ffffe00000ULL, 0x000001ffffe00000ULL, 0x000001ffffe00000ULL,
+    0x000000007fe00000ULL, 0x000000007fe00000ULL, 0x0000001fffe00000ULL, 0x0000001fffe00000ULL,
+    0x000000001ff80006ULL, 0x000000001ff80006ULL, 0x000000001fff0006ULL, 0x000000001fff0006ULL,
+    0x00000001ffffe01eULL, 0x00000001ffffe01eULL, 0x000000019ffff87eULL, 0x000000019ffff87eULL,
+    0x000000001ffffffeULL, 0x000000001ffffffeULL, 0x000000001ffffffeULL, 0x000000001ffffffeULL,
+    0x000000001ffffff8ULL, 0x0000000007fffff8ULL, 0x0000000007ffffe0ULL, 0x0000000007ffffe0ULL,
+    0x0000000001ffff80ULL, 0x0000000001ffff80ULL, 0x00000000007ffe00ULL, 0x00000000007ffe00ULL,
+    0x0000000003e1f800ULL, 0x0000000003e1f800ULL, 0x0000000000007800ULL, 0x0000000000007800ULL,
+    0x0000000000001800ULL, 0x0000000000001800ULL, 0x0000000000007800ULL, 0x0000000000007800ULL,
+    0x0000000000000000ULL
+};
+
+static const std::uint64_t DINO_LEFT_UP_ROWS[45] = {
+    0x0000000000000000ULL, 0x0000007fff800000ULL, 0x0000007fff800000ULL, 0x000001ffffe00000ULL,
+    0x000001fff9e00000ULL, 0x000001fff9e00000ULL, 0x000001ffffe00000ULL, 0x000001ffffe00000ULL,
+    0x000001ffffe00000ULL, 0x000001ffffe00000ULL, 0x000001ffffe00000ULL, 0x000001ffffe00000ULL,
+    0x000000007fe00000ULL, 0x000000007fe00000ULL, 0x0000001fffe00000ULL, 0x0000001fffe00000ULL,
+    0x000000001ff80006ULL, 0x000000001ff80006ULL, 0x000000001fff0006ULL, 0x000000001fff0006ULL,
+    0x00000001ffffe01eULL, 0x00000001ffffe01eULL, 0x000000019ffff87eULL, 0x000000019ffff87eULL,
+    0x000000001ffffffeULL, 0x000000001ffffffeULL, 0x000000001ffffffeULL, 0x000000001ffffffeULL,
+    0x000000001ffffff8ULL, 0x0000000007fffff8ULL, 0x0000000007ffffe0ULL, 0x0000000007ffffe0ULL,
+    0x0000000001ffff80ULL, 0x0000000001ffff80ULL, 0x00000000007ffe00ULL, 0x00000000007ffe00ULL,
+    0x0000000000787800ULL, 0x0000000000787800ULL, 0x000000000061e000ULL, 0x000000000061e000ULL,
+    0x0000000000600000ULL, 0x0000000000600000ULL, 0x0000000001e00000ULL, 0x0000000001e00000ULL,
+    0x0000000000000000ULL
+};
+
+static const std::uint64_t DINO_BELOW_RIGHT_UP_ROWS[28] = {
+    0x0000000000000000ULL, 0x0000000000000006ULL, 0x003fffc000000006ULL, 0x003fffc0ffff807eULL,
+    0x00fffff0ffff807eULL, 0x00fffcfffffffffeULL, 0x00fffcfffffffffeULL, 0x00fffffffffffff8ULL,
+    0x00fffffffffffff8ULL, 0x00ffffffffffffe0ULL, 0x00ffffffffffffe0ULL, 0x00ffffffffffff80ULL,
+    0x00ffffffffffff80ULL, 0x00003ffffffffe00ULL, 0x00003ffffffffe00ULL, 0x000fffc3fffff800ULL,
+    0x000fffc3fffff800ULL, 0x00000003ffffe000ULL, 0x00000000c1ffe000ULL, 0x00000000c7c3f000ULL,
+    0x00000003c7c3f000ULL, 0x00000003c000f000ULL, 0x000000000000f000ULL, 0x0000000000003000ULL,
+    0x0000000000003000ULL, 0x000000000000f000ULL, 0x000000000000f000ULL, 0x0000000000000000ULL
+};
+
+static const std::uint64_t DINO_BELOW_LEFT_UP_ROWS[28] = {
+    0x0000000000000000ULL, 0x0000000000000006ULL, 0x003fffc000000006ULL, 0x003fffc0ffff807eULL,
+    0x00fffff0ffff807eULL, 0x00fffcfffffffffeULL, 0x00fffcfffffffffeULL, 0x00fffffffffffff8ULL,
+    0x00fffffffffffff8ULL, 0x00ffffffffffffe0ULL, 0x00ffffffffffffe0ULL, 0x00ffffffffffff80ULL,
+    0x00ffffffffffff80ULL, 0x00003ffffffffe00ULL, 0x00003ffffffffe00ULL, 0x000fffc3fffff800ULL,
+    0x000fffc3fffff800ULL, 0x00000003ffffe000ULL, 0x00000000c1ffe000ULL, 0x00000000c0fc3000ULL,
+    0x00000003c0fc3000ULL, 0x00000003c03cf000ULL, 0x00000000003cf000ULL, 0x00000000000c0000ULL,
+    0x00000000000c0000ULL, 0x00000000003c0000ULL, 0x00000000003c0000ULL, 0x0000000000000000ULL
+};
+
+static const std::uint64_t DINO_BIG_EYES_ROWS[45] = {
+    0x0000000000000000ULL, 0x0000007fff800000ULL, 0x0000007fff800000ULL, 0x000001ffffe00000ULL,
+    0x000001ffe1e00000ULL, 0x000001ffe1e00000ULL, 0x000001ffe1e00000ULL, 0x000001ffe1e00000ULL,
+    0x000001ffffe00000ULL, 0x000001ffffe00000ULL, 0x000001ffffe00000ULL, 0x000001ffffe00000ULL,
+    0x000001ffffe00000ULL, 0x000001ffffe00000ULL, 0x0000001fffe00000ULL, 0x0000001fffe00000ULL,
+    0x000000001ff80006ULL, 0x000000001ff80006ULL, 0x000000001fff0006ULL, 0x000000001fff0006ULL,
+    0x00000001ffffe01eULL, 0x00000001ffffe01eULL, 0x000000019ffff87eULL, 0x000000019ffff87eULL,
+    0x000000001ffffffeULL, 0x000000001ffffffeULL, 0x000000001ffffffeULL, 0x000000001ffffffeULL,
+    0x000000001ffffff8ULL, 0x0000000007fffff8ULL, 0x0000000007ffffe0ULL, 0x0000000007ffffe0ULL,
+    0x0000000001ffff80ULL, 0x0000000001ffff80ULL, 0x00000000007ffe00ULL, 0x00000000007ffe00ULL,
+    0x000000000079f800ULL, 0x000000000079f800ULL, 0x0000000000607800ULL, 0x0000000000607800ULL,
+    0x0000000000601800ULL, 0x0000000000601800ULL, 0x0000000001e07800ULL, 0x0000000001e07800ULL,
+    0x0000000000000000ULL
+};
+
+static const std::uint64_t CACTUS_1_ROWS[48] = {
+    0x0000000000000000ULL, 0x0000000000007c00ULL, 0x000000000000fe00ULL, 0x000000000000fe00ULL,
+    0x000000000000fe00ULL, 0x000000000000fe00ULL, 0x000000000000fe00ULL, 0x000000000000fe00ULL,
+    0x000000000000fe00ULL, 0x000000000000fe00ULL, 0x000000000000fe00ULL, 0x000000000070fe00ULL,
+    0x0000000000f8fe00ULL, 0x0000000000f8fe1cULL, 0x0000000000f8fe3eULL, 0x0000000000f8fe3eULL,
+    0x0000000000f8fe3eULL, 0x0000000000f8fe3eULL, 0x0000000000f8fe3eULL, 0x0000000000f8fe3eULL,
+    0x0000000000f8fe3eULL, 0x0000000000f8fe3eULL, 0x0000000000f8fe3eULL, 0x0000000000f8fe3eULL,
+    0x0000000000f8fe3eULL, 0x0000000000f8fe3eULL, 0x0000000000f8fe3eULL, 0x00000000007ffffeULL,
+    0x00000000003ffffeULL, 0x00000000001ffffcULL, 0x00000000000ffff8ULL, 0x000000000000fff0ULL,
+    0x000000000000fe00ULL, 0x000000000000fe00ULL, 0x000000000000fe00ULL, 0x000000000000fe00ULL,
+    0x000000000000fe00ULL, 0x000000000000fe00ULL, 0x000000000000fe00ULL, 0x000000000000fe00ULL,
+    0x000000000000fe00ULL, 0x000000000000fe00ULL, 0x000000000000fe00ULL, 0x000000000000fe00ULL,
+    0x000000000000fe00ULL, 0x000000000000fe00ULL, 0x000000000000ff80ULL, 0x0000000000000000ULL
+};
+
+static const std::uint64_t CACTUS_2_ROWS[35] = {
+    0x0000000000000000ULL, 0x0000000000000380ULL, 0x00000000000007c0ULL, 0x00000000000007c0ULL,
+    0x00000000000007c0ULL, 0x00000000000047c0ULL, 0x000000000000e7c0ULL, 0x000000000000e7c0ULL,
+    0x000000000000e7c0ULL, 0x000000000000e7c4ULL, 0x000000000000e7ceULL, 0x000000000000e7ceULL,
+    0x000000000000e7ceULL, 0x000000000000e7ceULL, 0x000000000000e7ceULL, 0x000000000000e7ceULL,
+    0x000000000000ffceULL, 0x0000000000007fceULL, 0x0000000000003fceULL, 0x00000000000007ceULL,
+    0x00000000000007feULL, 0x00000000000007fcULL, 0x00000000000007f8ULL, 0x00000000000007c0ULL,
+    0x00000000000007c0ULL, 0x00000000000007c0ULL, 0x00000000000007c0ULL, 0x00000000000007c0ULL,
+    0x00000000000007c0ULL, 0x00000000000007c0ULL, 0x00000000000007c0ULL, 0x00000000000007c0ULL,
+    0x00000000000007c0ULL, 0x00000000000007c0ULL, 0x0000000000000000ULL
+};
+
+static const std::uint64_t CACTUS_3_ROWS[49] = {
+    0x0000000000000000ULL, 0x000001f000000000ULL, 0x000003f800000000ULL, 0x000003f800000700ULL,
+    0x000003f800000f80ULL, 0x000003f800000f80ULL, 0x000003f800000f80ULL, 0x000003f870000f80ULL,
+    0x000003f8f8010f80ULL, 0x000003f8f8038f80ULL, 0x000003f8f8038f80ULL, 0x000003f8f8038f80ULL,
+    0x0001c3f8f8038f80ULL, 0x0003e3f8f8038f80ULL, 0x0003e3f8f8038f80ULL, 0x0003e3f8f8038f80ULL,
+    0x0003e3f8f8038f80ULL, 0x0003e3f8f8038f8cULL, 0x0003e3f8f803ff9eULL, 0x0003e3f8f801ff9eULL,
+    0x0003e3f8f820ff9eULL, 0x0003e3fff8700f9eULL, 0x0003e3fff8700f9eULL, 0x0003e3fff0700f9eULL,
+    0x0003e3ffe0700f9eULL, 0x0003e3ffc4710f9eULL, 0x0003e3f80e738f9eULL, 0x0001e3f80e738f9eULL,
+    0x0000fff80e738f9eULL, 0x00007ff80e738f9eULL, 0x00003ff80e738ffeULL, 0x000003f80e738ffcULL,
+    0x000003f80e738ff8ULL, 0x000003f80e738ff0ULL, 0x000003f80e738f80ULL, 0x000003f807ff0f80ULL,
+    0x000003f803fe0f80ULL, 0x000003f8007c0f80ULL, 0x000003f800700f80ULL, 0x000003f800700f80ULL,
+    0x000003f800700f80ULL, 0x000003f800700f80ULL, 0x000003f800700f80ULL, 0x000003f800700f80ULL,
+    0x000003f800700f80ULL, 0x000003f800700f80ULL, 0x000003f800700f80ULL, 0x000003fe00700f80ULL,
+    0x0000040000000000ULL
+};
+
+static const std::uint64_t CACTUS_4_ROWS[49] = {
+    0x0000000000000000ULL, 0x000000f800007c00ULL, 0x000001fc0000fe00ULL, 0x000001fc0000fe00ULL,
+    0x000001fc0000fe00ULL, 0x000001fc0000fe00ULL, 0x000001fc0000fe1cULL, 0x000001fc0000fe3eULL,
+    0x000001fc0000fe3eULL, 0x000001fc0000fe3eULL, 0x000001fc0000fe3eULL, 0x000001fc0070fe3eULL,
+    0x000061fc00f8fe3eULL, 0x0000f1fc38f8fe3eULL, 0x0000f1fc7cf8fe3eULL, 0x0000f1fc7cf8fe3eULL,
+    0x0000f1fc7cf8fe3eULL, 0x0000f1fc7cf8fe3eULL, 0x0000f1fc7cf8fe3eULL, 0x0000f1fc7cf8fe3eULL,
+    0x0000f1fc7cf8fe3eULL, 0x0000f1fc7cf8fffeULL, 0x0000f1fc7cf8fffcULL, 0x0000f1fc7cf8fff8ULL,
+    0x0000f1fc7cf8fff0ULL, 0x0000f1fc7cf8ffe0ULL, 0x0000f1fc7cf8fe00ULL, 0x0000f1fc7c7ffe00ULL,
+    0x00007ffffc3ffe00ULL, 0x00003ffff81ffe00ULL, 0x00001ffff00ffe00ULL, 0x000001ffe000fe00ULL,
+    0x000001ffc000fe00ULL, 0x000001fc0000fe00ULL, 0x000001fc0000fe00ULL, 0x000001fc0000fe00ULL,
+    0x000001fc0000fe00ULL, 0x000001fc0000fe00ULL, 0x000001fc0000fe00ULL, 0x000001fc0000fe00ULL,
+    0x000001fc0000fe00ULL, 0x000001fc0000fe00ULL, 0x000001fc0000fe00ULL, 0x000001fc0000fe00ULL,
+    0x000001fc0000fe00ULL, 0x000001fc0000fe00ULL, 0x000001fc0000ff80ULL, 0x000001ff00000000ULL,
+    0x0000020000000000ULL
+};
+
+static const std::uint64_t CACTUS_5_ROWS[35] = {
+    0x0000000000000000ULL, 0x0000000007000380ULL, 0x000000000f8007c0ULL, 0x000000000f8007c0ULL,
+    0x000000000f8007c0ULL, 0x000000008f8047ccULL, 0x00000001cf80e7deULL, 0x00000001cf80e7deULL,
+    0x00000001cf80e7deULL, 0x00000001cf88e7deULL, 0x00000001cf9ce7deULL, 0x00000001cf9ce7deULL,
+    0x00000001cf9ce7deULL, 0x00000001cf9ce7feULL, 0x00000001cf9ce7feULL, 0x00000001cf9ce7fcULL,
+    0x00000001ff9ce7f8ULL, 0x00000000ff9ce7c0ULL, 0x000000007f9cffc0ULL, 0x000000000f9c7fc0ULL,
+    0x000000000ffc3fc0ULL, 0x000000000ff807c0ULL, 0x000000000ff007c0ULL, 0x000000000f8007c0ULL,
+    0x000000000f8007c0ULL, 0x000000000f8007c0ULL, 0x000000000f8007c0ULL, 0x000000000f8007c0ULL,
+    0x000000000f8007c0ULL, 0x000000000f8007c0ULL, 0x000000000f8007c0ULL, 0x000000000f8007c0ULL,
+    0x000000000f8007c0ULL, 0x000000000f8007c0ULL, 0x0000000000000000ULL
+};
+
+static const std::uint64_t PTERO_DOWN_ROWS[50] = {
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x000000000003c000ULL,
+    0x000000000003c000ULL, 0x00000000000ff000ULL, 0x00000000000ff003ULL, 0x00000000000ffc03ULL,
+    0x00000000000ffc06ULL, 0x00000000003fff07ULL, 0x00000000003fff07ULL, 0x00000003ffffffc0ULL,
+    0x00000003ffffffc0ULL, 0x0000000ffffffff0ULL, 0x0000000ffffffff0ULL, 0x0003fffffffffff0ULL,
+    0x0003fffffffffff0ULL, 0x0003fffffffc0000ULL, 0x0003fffffffc0000ULL, 0x0000fffffff00000ULL,
+    0x0000fffffff00000ULL, 0x0000fffffff00000ULL, 0x0000fffffff00000ULL, 0x00003ffffff00000ULL,
+    0x00003ffffff00000ULL, 0x000000fffff00000ULL, 0x000000fffff00000ULL, 0x000000003ff00000ULL,
+    0x000000003ff00000ULL, 0x000000000ff00000ULL, 0x000000000ff00000ULL, 0x000000000ff00000ULL,
+    0x000000000ff00000ULL, 0x0000000003f00000ULL, 0x0000000003f00000ULL, 0x0000000000c00000ULL,
+    0x0000000000c00000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL
+};
+
+static const std::uint64_t PTERO_UP_ROWS[50] = {
+    0x0000000000000000ULL, 0x0000000000180000ULL, 0x0000000000180000ULL, 0x00000000007e0000ULL,
+    0x00000000007e0000ULL, 0x0000000001fe0000ULL, 0x0000000001fe0000ULL, 0x0000000007ffe000ULL,
+    0x0000000007ffe000ULL, 0x000000001ffff800ULL, 0x000000001ffff800ULL, 0x000000007ffffe00ULL,
+    0x000000007ffffe00ULL, 0x00000001ffffff80ULL, 0x00000001ffffff80ULL, 0x00000007ffffffe0ULL,
+    0x00000007ffffffe0ULL, 0x00000007fffffff8ULL, 0x00000007fffffff8ULL, 0x00007fffffffffe7ULL,
+    0x00007fffffffffe7ULL, 0x0001fffffffe0007ULL, 0x0001fffffffe0007ULL, 0x00007ffffff80001ULL,
+    0x00007ffffff80001ULL, 0x00007fffffe00001ULL, 0x00007fffffe00001ULL, 0x00001fffff800000ULL,
+    0x00001fffff800000ULL, 0x000001fffe000000ULL, 0x000001fffe000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL
+};
+
+const HitMask DINO_MASKS[DINO_FRAME_COUNT] = {
+    {42, 45, DINO_STAND_ROWS},
+    {42, 45, DINO_RIGHT_UP_ROWS},
+    {42, 45, DINO_LEFT_UP_ROWS},
+    {57, 28, DINO_BELOW_RIGHT_UP_ROWS},
+    {57, 28, DINO_BELOW_LEFT_UP_ROWS},
+    {42, 45, DINO_BIG_EYES_ROWS}
+};
+
+const HitMask CACTUS_MASKS[CACTUS_TYPES] = {
+    {25, 48, CACTUS_1_ROWS},
+    {17, 35, CACTUS_2_ROWS},
+    {51, 49, CACTUS_3_ROWS},
+    {49, 49, CACTUS_4_ROWS},
+    {34, 35, CACTUS_5_ROWS}
+};
+
+const HitMask PTERO_MASKS[2] = {
+    {50, 50, PTERO_DOWN_ROWS},
+    {50, 50, PTERO_UP_ROWS}
+};
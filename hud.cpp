@@ -0,0 +1,99 @@
+#include "hud.h"
+#include <cstring>
+
+const std::size_t HUD_TEXT_RESERVE = 1024;
+
+HudText::HudText() {
+    shown.reserve(HUD_TEXT_RESERVE);
+}
+
+bool HudText::set(const char* value) {
+    if (shown == value) return false;
+    shown.assign(value);
+
+    // setString(std::string) would convert through a temporary sf::String
+    buffer.clear();
+    for (const char* c = value; *c; ++c) {
+        buffer += sf::String(static_cast<sf::Uint32>(static_cast<unsigned char>(*c)));
+    }
+    text.setString(buffer);
+    return true;
+}
+
+HudCounter::HudCounter()
+    : texture(nullptr), valueX(0), baseline(0), labelLength(0), length(0) {
+    shown[0] = '\0';
+}
+
+void HudCounter::setup(const sf::Font& font, unsigned size, const sf::Color& color, float x, float y, const char* label) {
+    this->color = color;
+    baseline = y + size;    // where sf::Text puts the baseline
+
+    // Loading every strip glyph now keeps later updates off the font cache
+    for (int i = 0; i < HUD_STRIP_SIZE; ++i) {
+        strip[i] = font.getGlyph(static_cast<unsigned char>(HUD_STRIP_CHARS[i]), size, false);
+    }
+
+    float pen = x;
+    labelLength = 0;
+    for (const char* c = label; *c && labelLength < HUD_COUNTER_GLYPHS; ++c) {
+        const sf::Glyph& glyph = font.getGlyph(static_cast<unsigned char>(*c), size, false);
+        placeGlyph(labelLength, glyph, pen);
+        shown[labelLength] = *c;
+        penX[labelLength] = pen;
+        pen += glyph.advance;
+        labelLength++;
+    }
+    valueX = pen;
+    length = labelLength;
+    shown[length] = '\0';
+    texture = &font.getTexture(size);
+}
+
+void HudCounter::placeGlyph(int index, const sf::Glyph& glyph, float x) {
+    float left = x + glyph.bounds.left;
+    float top = baseline + glyph.bounds.top;
+    float right = left + glyph.bounds.width;
+    float bottom = top + glyph.bounds.height;
+    float u0 = static_cast<float>(glyph.textureRect.left);
+    float v0 = static_cast<float>(glyph.textureRect.top);
+    float u1 = u0 + glyph.textureRect.width;
+    float v1 = v0 + glyph.textureRect.height;
+
+    sf::Vertex* quad = &vertices[index * 4];
+    quad[0] = sf::Vertex(sf::Vector2f(left, top), color, sf::Vector2f(u0, v0));
+    quad[1] = sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u1, v0));
+    quad[2] = sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(u1, v1));
+    quad[3] = sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u0, v1));
+}
+
+int HudCounter::set(const char* value) {
+    int rewritten = 0;
+    int index = labelLength;
+    float pen = valueX;
+    for (const char* c = value; *c && index < HUD_COUNTER_GLYPHS; ++c) {
+        const char* found = std::strchr(HUD_STRIP_CHARS, *c);
+        if (!found) continue;
+        const sf::Glyph& glyph = strip[found - HUD_STRIP_CHARS];
+
+        // Digits share one advance, so usually only the changed ones move
+        if (index >= length || shown[index] != *c || penX[index] != pen) {
+            placeGlyph(index, glyph, pen);
+            shown[index] = *c;
+            penX[index] = pen;
+            rewritten++;
+        }
+        pen += glyph.advance;
+        index++;
+    }
+    // A shorter value just draws fewer quads
+    length = index;
+    shown[length] = '\0';
+    return rewritten;
+}
+
+void HudCounter::draw(sf::RenderTarget& target) const {
+    if (length > 0 && texture) {
+        target.draw(vertices, length * 4, sf::Quads, sf::RenderStates(texture));
+    }
+}
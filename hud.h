@@ -0,0 +1,54 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// Text that only re-lays out its glyphs when the string actually changes.
+// The last value and the sf::String handed to SFML are reused buffers, so
+// an update allocates nothing once they have grown to size.
+class HudText {
+public:
+    sf::Text text;
+
+    HudText();
+    // Returns true if the string changed and the text was rebuilt
+    bool set(const char* value);
+
+private:
+    std::string shown;
+    sf::String buffer;
+};
+
+const int HUD_COUNTER_GLYPHS = 32;           // label plus value
+const char HUD_STRIP_CHARS[] = "0123456789.-";
+const int HUD_STRIP_SIZE = sizeof(HUD_STRIP_CHARS) - 1;
+
+// A fixed label followed by a number, drawn as one batch of glyph quads out
+// of the font's own texture. The digit strip is looked up once in setup(),
+// and set() rewrites only the quads whose character or position changed.
+// Characters outside HUD_STRIP_CHARS are not drawn.
+class HudCounter {
+public:
+    HudCounter();
+    void setup(const sf::Font& font, unsigned size, const sf::Color& color, float x, float y, const char* label);
+    // Returns the number of glyph quads rewritten, 0 if the value is unchanged
+    int set(const char* value);
+    void draw(sf::RenderTarget& target) const;
+
+private:
+    const sf::Texture* texture;
+    sf::Glyph strip[HUD_STRIP_SIZE];
+    sf::Color color;
+    float valueX;
+    float baseline;
+    int labelLength;
+    int length;                              // glyphs in use, label included
+    char shown[HUD_COUNTER_GLYPHS + 1];
+    float penX[HUD_COUNTER_GLYPHS];
+    sf::Vertex vertices[HUD_COUNTER_GLYPHS * 4];
+
+    void placeGlyph(int index, const sf::Glyph& glyph, float x);
+};
+
+#endif // HUD_H
@@ -1,7 +1,135 @@
 #include "dinogame.h"
+#include "stress.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
 
-int main() {
-    DinoGame game;
-    game.run();
-    return 0;
+// Re-runs a replay headless and checks it reaches the recorded score
+int verifyReplay(const char* path) {
+    Replay replay;
+    if (!replay.load(path)) {
+        std::cerr << "Failed to load replay " << path << std::endl;
+        return 1;
+    }
+    
+    DinoSim sim;
+    auto start = std::chrono::steady_clock::now();
+    bool valid = replay.verify(sim);
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << (valid ? "OK" : "MISMATCH") << ": seed " << replay.seed
+              << ", recorded score " << replay.finalScore << " at tick " << replay.finalTick
+              << ", replayed score " << sim.score << " at tick " << sim.gameTicks
+              << " (" << replay.events.size() << " events, " << micros << " us)" << std::endl;
+    return valid ? 0 : 1;
+}
+
+// Stress mode: its own flags, then a fixed-length benchmark run
+int runStress(int argc, char* argv[], const std::string& bundlePath) {
+    StressOptions options;
+    options.seed = 1;
+    options.bundlePath = bundlePath;
+    options.frames = 3000;
+    options.cactusTicks = 1;
+    options.pteroTicks = 3;
+    options.pool = WIDE_MAX_OBSTACLES;
+    options.worldWidth = 20000;
+    options.sprites = false;
+    
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--bundle") == 0 && i + 1 < argc) {
+            options.bundlePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            options.frames = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--cactus-ticks") == 0 && i + 1 < argc) {
+            options.cactusTicks = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--ptero-ticks") == 0 && i + 1 < argc) {
+            options.pteroTicks = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--pool") == 0 && i + 1 < argc) {
+            options.pool = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--world-width") == 0 && i + 1 < argc) {
+            options.worldWidth = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--sprites") == 0) {
+            options.sprites = true;
+        }
+    }
+    options.frames = std::max(options.frames, 1);
+    options.cactusTicks = std::max(options.cactusTicks, 1);
+    options.pteroTicks = std::max(options.pteroTicks, 1);
+    options.pool = std::max(1, std::min(options.pool, WIDE_MAX_OBSTACLES));
+    options.worldWidth = std::max(options.worldWidth, static_cast<float>(WINDOW_WIDTH));
+    
+    StressRun stress(options);
+    return stress.run();
+}
+
+int main(int argc, char* argv[]) {
+    GameOptions options;
+    options.seed = std::random_device{}();
+    options.autopilot = false;
+    options.vsync = true;
+    options.lowLatency = false;
+    options.allocCheck = false;
+    
+    // A bundle next to the executable wins, so the game starts from any directory
+    std::string bundleNextToExecutable = executableDirectory(argv[0]) + BUNDLE_FILE_NAME;
+    options.bundlePath = std::ifstream(bundleNextToExecutable) ? bundleNextToExecutable : BUNDLE_FILE_NAME;
+    
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--stress") == 0) {
+            return runStress(argc, argv, options.bundlePath);
+        }
+    }
+    
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            options.recordPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            options.replayPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--genome") == 0 && i + 1 < argc) {
+            options.genomePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--autopilot") == 0) {
+            options.autopilot = true;
+        }
+        else if (std::strcmp(argv[i], "--no-vsync") == 0) {
+            options.vsync = false;
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            options.tracePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--low-latency") == 0) {
+            options.lowLatency = true;
+        }
+        else if (std::strcmp(argv[i], "--bundle") == 0 && i + 1 < argc) {
+            options.bundlePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--alloc-check") == 0) {
+            options.allocCheck = true;
+        }
+        else if (std::strcmp(argv[i], "--verify") == 0 && i + 1 < argc) {
+            return verifyReplay(argv[++i]);
+        }
+    }
+    
+    DinoGame game(options);
+    return game.run();
 }
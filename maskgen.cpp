@@ -0,0 +1,96 @@
+// Writes hitmasks.cpp from the sprite PNGs:
+//   g++ -std=c++17 maskgen.cpp -o maskgen -lsfml-graphics -lsfml-system
+//   ./maskgen > hitmasks.cpp
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+const unsigned ALPHA_THRESHOLD = 128;
+
+struct MaskSource {
+    const char* file;
+    const char* name;
+    unsigned downscale;    // pterodactyls are drawn at half size
+};
+
+const MaskSource SOURCES[] = {
+    {"Dino-stand.png", "DINO_STAND", 1},
+    {"Dino-right-up.png", "DINO_RIGHT_UP", 1},
+    {"Dino-left-up.png", "DINO_LEFT_UP", 1},
+    {"Dino-below-right-up.png", "DINO_BELOW_RIGHT_UP", 1},
+    {"Dino-below-left-up.png", "DINO_BELOW_LEFT_UP", 1},
+    {"Dino-big-eyes.png", "DINO_BIG_EYES", 1},
+    {"Cactus-1.png", "CACTUS_1", 1},
+    {"Cactus-2.png", "CACTUS_2", 1},
+    {"Cactus-3.png", "CACTUS_3", 1},
+    {"Cactus-4.png", "CACTUS_4", 1},
+    {"Cactus-5.png", "CACTUS_5", 1},
+    {"Ptero-down.png", "PTERO_DOWN", 2},
+    {"Ptero-up.png", "PTERO_UP", 2}
+};
+
+struct MaskGroup {
+    const char* name;
+    const char* count;
+    int first;
+    int size;
+};
+
+const MaskGroup GROUPS[] = {
+    {"DINO_MASKS", "DINO_FRAME_COUNT", 0, 6},
+    {"CACTUS_MASKS", "CACTUS_TYPES", 6, 5},
+    {"PTERO_MASKS", "2", 11, 2}
+};
+
+int main() {
+    const int count = sizeof(SOURCES) / sizeof(SOURCES[0]);
+    std::vector<unsigned> widths(count), heights(count);
+    
+    std::printf("// Generated by maskgen.cpp from the sprite PNGs. Do not edit.\n");
+    std::printf("#include \"collision.h\"\n");
+    
+    for (int i = 0; i < count; ++i) {
+        sf::Image image;
+        if (!image.loadFromFile(SOURCES[i].file)) {
+            std::fprintf(stderr, "Failed to load %s\n", SOURCES[i].file);
+            return 1;
+        }
+        
+        // A downscaled pixel is solid if any pixel of its source block is
+        unsigned scale = SOURCES[i].downscale;
+        widths[i] = image.getSize().x / scale;
+        heights[i] = image.getSize().y / scale;
+        if (widths[i] > 64) {
+            std::fprintf(stderr, "%s is wider than 64 pixels\n", SOURCES[i].file);
+            return 1;
+        }
+        
+        std::printf("\nstatic const std::uint64_t %s_ROWS[%u] = {", SOURCES[i].name, heights[i]);
+        for (unsigned y = 0; y < heights[i]; ++y) {
+            std::uint64_t row = 0;
+            for (unsigned x = 0; x < widths[i]; ++x) {
+                for (unsigned sy = 0; sy < scale; ++sy) {
+                    for (unsigned sx = 0; sx < scale; ++sx) {
+                        if (image.getPixel(x * scale + sx, y * scale + sy).a >= ALPHA_THRESHOLD) {
+                            row |= std::uint64_t(1) << x;
+                        }
+                    }
+                }
+            }
+            std::printf("%s0x%016llxULL%s", y % 4 == 0 ? "\n    " : " ",
+                        static_cast<unsigned long long>(row), y + 1 < heights[i] ? "," : "");
+        }
+        std::printf("\n};\n");
+    }
+    
+    for (const auto& group : GROUPS) {
+        std::printf("\nconst HitMask %s[%s] = {\n", group.name, group.count);
+        for (int i = group.first; i < group.first + group.size; ++i) {
+            std::printf("    {%u, %u, %s_ROWS}%s\n", widths[i], heights[i], SOURCES[i].name,
+                        i + 1 < group.first + group.size ? "," : "");
+        }
+        std::printf("};\n");
+    }
+    return 0;
+}
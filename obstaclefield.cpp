@@ -0,0 +1,257 @@
+#include "obstaclefield.h"
+#include <cstdlib>
+#include <new>
+#include "dinosim.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+const std::size_t FIELD_ALIGNMENT = 32;
+const int FIELD_LANES = 8;    // capacity is rounded up to whole AVX2 chunks
+
+template <class T>
+static T* alignedColumn(int capacity) {
+    // aligned_alloc needs a size that is a multiple of the alignment; the byte columns are not
+    std::size_t size = (sizeof(T) * capacity + FIELD_ALIGNMENT - 1) / FIELD_ALIGNMENT * FIELD_ALIGNMENT;
+    if (void* p = std::aligned_alloc(FIELD_ALIGNMENT, size)) return static_cast<T*>(p);
+    throw std::bad_alloc();
+}
+
+ObstacleField::ObstacleField(int capacity)
+    : count(0), limit((capacity + FIELD_LANES - 1) / FIELD_LANES * FIELD_LANES) {
+    x = alignedColumn<float>(limit);
+    y = alignedColumn<float>(limit);
+    width = alignedColumn<float>(limit);
+    height = alignedColumn<float>(limit);
+    despawnX = alignedColumn<float>(limit);
+    animationTicks = alignedColumn<std::int32_t>(limit);
+    frame = alignedColumn<std::int32_t>(limit);
+    kind = alignedColumn<std::uint8_t>(limit);
+    type = alignedColumn<std::uint8_t>(limit);
+    culled = alignedColumn<int>(limit);
+}
+
+ObstacleField::~ObstacleField() {
+    std::free(x);
+    std::free(y);
+    std::free(width);
+    std::free(height);
+    std::free(despawnX);
+    std::free(animationTicks);
+    std::free(frame);
+    std::free(kind);
+    std::free(type);
+    std::free(culled);
+}
+
+int ObstacleField::size() const {
+    return count;
+}
+
+int ObstacleField::capacity() const {
+    return limit;
+}
+
+void ObstacleField::clear() {
+    count = 0;
+}
+
+bool ObstacleField::add(const Obstacle& obstacle) {
+    if (count == limit) return false;
+    x[count] = obstacle.x;
+    y[count] = obstacle.y;
+    width[count] = obstacle.width;
+    height[count] = obstacle.height;
+    despawnX[count] = obstacle.kind == OBSTACLE_PTERO ? -100 : -50;
+    animationTicks[count] = obstacle.animationTicks;
+    frame[count] = obstacle.frame;
+    kind[count] = obstacle.kind;
+    type[count] = obstacle.type;
+    count++;
+    return true;
+}
+
+Obstacle ObstacleField::get(int index) const {
+    Obstacle obstacle = Obstacle();
+    obstacle.x = x[index];
+    obstacle.y = y[index];
+    obstacle.width = width[index];
+    obstacle.height = height[index];
+    obstacle.kind = kind[index];
+    obstacle.type = type[index];
+    obstacle.frame = static_cast<std::uint8_t>(frame[index]);
+    obstacle.alive = 1;
+    obstacle.animationTicks = animationTicks[index];
+    return obstacle;
+}
+
+void ObstacleField::remove(int index) {
+    int last = --count;
+    x[index] = x[last];
+    y[index] = y[last];
+    width[index] = width[last];
+    height[index] = height[last];
+    despawnX[index] = despawnX[last];
+    animationTicks[index] = animationTicks[last];
+    frame[index] = frame[last];
+    kind[index] = kind[last];
+    type[index] = type[last];
+}
+
+// Cacti carry a timer too; it is simply never shown. One wrap per call is
+// enough for the vector path, longer steps take the scalar one.
+int ObstacleField::advance(float speed, int ticks) {
+    float shift = speed * ticks;
+    int dead = 0;
+    int i = 0;
+    if (ticks < PTERO_ANIMATION_TICKS) {
+#if defined(__AVX2__)
+        __m256 step = _mm256_set1_ps(shift);
+        __m256i elapsed = _mm256_set1_epi32(ticks);
+        __m256i period = _mm256_set1_epi32(PTERO_ANIMATION_TICKS);
+        __m256i last = _mm256_set1_epi32(PTERO_ANIMATION_TICKS - 1);
+        __m256i one = _mm256_set1_epi32(1);
+        for (; i + 8 <= count; i += 8) {
+            __m256 position = _mm256_sub_ps(_mm256_load_ps(x + i), step);
+            _mm256_store_ps(x + i, position);
+            
+            __m256i timer = _mm256_add_epi32(_mm256_load_si256(reinterpret_cast<const __m256i*>(animationTicks + i)), elapsed);
+            __m256i wrap = _mm256_cmpgt_epi32(timer, last);
+            timer = _mm256_sub_epi32(timer, _mm256_and_si256(wrap, period));
+            __m256i wing = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(frame + i)),
+                                            _mm256_and_si256(wrap, one));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(animationTicks + i), timer);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(frame + i), wing);
+            
+            int gone = _mm256_movemask_ps(_mm256_cmp_ps(position, _mm256_load_ps(despawnX + i), _CMP_LT_OQ));
+            for (; gone; gone &= gone - 1) {
+                culled[dead++] = i + __builtin_ctz(gone);
+            }
+        }
+#elif defined(__SSE2__)
+        __m128 step = _mm_set1_ps(shift);
+        __m128i elapsed = _mm_set1_epi32(ticks);
+        __m128i period = _mm_set1_epi32(PTERO_ANIMATION_TICKS);
+        __m128i last = _mm_set1_epi32(PTERO_ANIMATION_TICKS - 1);
+        __m128i one = _mm_set1_epi32(1);
+        for (; i + 4 <= count; i += 4) {
+            __m128 position = _mm_sub_ps(_mm_load_ps(x + i), step);
+            _mm_store_ps(x + i, position);
+            
+            __m128i timer = _mm_add_epi32(_mm_load_si128(reinterpret_cast<const __m128i*>(animationTicks + i)), elapsed);
+            __m128i wrap = _mm_cmpgt_epi32(timer, last);
+            timer = _mm_sub_epi32(timer, _mm_and_si128(wrap, period));
+            __m128i wing = _mm_xor_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(frame + i)),
+                                         _mm_and_si128(wrap, one));
+            _mm_store_si128(reinterpret_cast<__m128i*>(animationTicks + i), timer);
+            _mm_store_si128(reinterpret_cast<__m128i*>(frame + i), wing);
+            
+            int gone = _mm_movemask_ps(_mm_cmplt_ps(position, _mm_load_ps(despawnX + i)));
+            for (; gone; gone &= gone - 1) {
+                culled[dead++] = i + __builtin_ctz(gone);
+            }
+        }
+#elif defined(__ARM_NEON)
+        float32x4_t step = vdupq_n_f32(shift);
+        int32x4_t elapsed = vdupq_n_s32(ticks);
+        int32x4_t period = vdupq_n_s32(PTERO_ANIMATION_TICKS);
+        int32x4_t one = vdupq_n_s32(1);
+        for (; i + 4 <= count; i += 4) {
+            float32x4_t position = vsubq_f32(vld1q_f32(x + i), step);
+            vst1q_f32(x + i, position);
+            
+            int32x4_t timer = vaddq_s32(vld1q_s32(animationTicks + i), elapsed);
+            int32x4_t wrap = vreinterpretq_s32_u32(vcgeq_s32(timer, period));
+            timer = vsubq_s32(timer, vandq_s32(wrap, period));
+            vst1q_s32(animationTicks + i, timer);
+            vst1q_s32(frame + i, veorq_s32(vld1q_s32(frame + i), vandq_s32(wrap, one)));
+            
+            std::uint32_t gone[4];
+            vst1q_u32(gone, vcltq_f32(position, vld1q_f32(despawnX + i)));
+            for (int lane = 0; lane < 4; ++lane) {
+                if (gone[lane]) culled[dead++] = i + lane;
+            }
+        }
+#endif
+    }
+    for (; i < count; ++i) {
+        x[i] -= shift;
+        int total = animationTicks[i] + ticks;
+        animationTicks[i] = total % PTERO_ANIMATION_TICKS;
+        frame[i] ^= (total / PTERO_ANIMATION_TICKS) & 1;
+        if (x[i] < despawnX[i]) culled[dead++] = i;
+    }
+    
+    // Highest index first, so whatever is swapped in from the end is live
+    for (int k = dead - 1; k >= 0; --k) {
+        remove(culled[k]);
+    }
+    return dead;
+}
+
+int ObstacleField::overlapping(float left, float top, float boxWidth, float boxHeight, int* out) const {
+    float right = left + boxWidth;
+    float bottom = top + boxHeight;
+    int found = 0;
+    int i = 0;
+#if defined(__AVX2__)
+    __m256 boxLeft = _mm256_set1_ps(left);
+    __m256 boxTop = _mm256_set1_ps(top);
+    __m256 boxRight = _mm256_set1_ps(right);
+    __m256 boxBottom = _mm256_set1_ps(bottom);
+    for (; i + 8 <= count; i += 8) {
+        __m256 ox = _mm256_load_ps(x + i);
+        __m256 oy = _mm256_load_ps(y + i);
+        __m256 hit = _mm256_and_ps(
+            _mm256_and_ps(_mm256_cmp_ps(ox, boxRight, _CMP_LT_OQ),
+                          _mm256_cmp_ps(boxLeft, _mm256_add_ps(ox, _mm256_load_ps(width + i)), _CMP_LT_OQ)),
+            _mm256_and_ps(_mm256_cmp_ps(oy, boxBottom, _CMP_LT_OQ),
+                          _mm256_cmp_ps(boxTop, _mm256_add_ps(oy, _mm256_load_ps(height + i)), _CMP_LT_OQ)));
+        for (int mask = _mm256_movemask_ps(hit); mask; mask &= mask - 1) {
+            out[found++] = i + __builtin_ctz(mask);
+        }
+    }
+#elif defined(__SSE2__)
+    __m128 boxLeft = _mm_set1_ps(left);
+    __m128 boxTop = _mm_set1_ps(top);
+    __m128 boxRight = _mm_set1_ps(right);
+    __m128 boxBottom = _mm_set1_ps(bottom);
+    for (; i + 4 <= count; i += 4) {
+        __m128 ox = _mm_load_ps(x + i);
+        __m128 oy = _mm_load_ps(y + i);
+        __m128 hit = _mm_and_ps(
+            _mm_and_ps(_mm_cmplt_ps(ox, boxRight), _mm_cmplt_ps(boxLeft, _mm_add_ps(ox, _mm_load_ps(width + i)))),
+            _mm_and_ps(_mm_cmplt_ps(oy, boxBottom), _mm_cmplt_ps(boxTop, _mm_add_ps(oy, _mm_load_ps(height + i)))));
+        for (int mask = _mm_movemask_ps(hit); mask; mask &= mask - 1) {
+            out[found++] = i + __builtin_ctz(mask);
+        }
+    }
+#elif defined(__ARM_NEON)
+    float32x4_t boxLeft = vdupq_n_f32(left);
+    float32x4_t boxTop = vdupq_n_f32(top);
+    float32x4_t boxRight = vdupq_n_f32(right);
+    float32x4_t boxBottom = vdupq_n_f32(bottom);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t ox = vld1q_f32(x + i);
+        float32x4_t oy = vld1q_f32(y + i);
+        std::uint32_t hit[4];
+        vst1q_u32(hit, vandq_u32(
+            vandq_u32(vcltq_f32(ox, boxRight), vcltq_f32(boxLeft, vaddq_f32(ox, vld1q_f32(width + i)))),
+            vandq_u32(vcltq_f32(oy, boxBottom), vcltq_f32(boxTop, vaddq_f32(oy, vld1q_f32(height + i))))));
+        for (int lane = 0; lane < 4; ++lane) {
+            if (hit[lane]) out[found++] = i + lane;
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        if (x[i] < right && left < x[i] + width[i] && y[i] < bottom && top < y[i] + height[i]) {
+            out[found++] = i;
+        }
+    }
+    return found;
+}
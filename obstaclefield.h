@@ -0,0 +1,55 @@
+#ifndef OBSTACLEFIELD_H
+#define OBSTACLEFIELD_H
+
+#include <cstdint>
+#include "obstacles.h"
+
+// Structure-of-arrays obstacle store for batch simulation (see fieldbench),
+// where thousands of obstacles are live at once. Every column is 32-byte
+// aligned so advance() and overlapping() run 8 (AVX2) or 4 (SSE2/NEON)
+// obstacles per instruction. Order is not kept: a culled obstacle is
+// replaced by the last one.
+//
+// DinoSim keeps its 16-slot ObstacleRing: game state has to stay a single
+// memcpy for the planner, and sweeping a handful of obstacles is cheaper
+// than gathering them.
+class ObstacleField {
+public:
+    // Columns, valid for [0, size())
+    float* x;
+    float* y;
+    float* width;
+    float* height;
+    float* despawnX;                 // culled once x drops below this
+    std::int32_t* animationTicks;
+    std::int32_t* frame;             // pterodactyl wing frame, 0 = down
+    std::uint8_t* kind;
+    std::uint8_t* type;
+
+    explicit ObstacleField(int capacity);
+    ~ObstacleField();
+    ObstacleField(const ObstacleField&) = delete;
+    ObstacleField& operator=(const ObstacleField&) = delete;
+
+    int size() const;
+    int capacity() const;
+    void clear();
+    bool add(const Obstacle& obstacle);
+    Obstacle get(int index) const;
+
+    // Moves everything left by speed per tick for `ticks` ticks, runs the
+    // wing animation and culls what left the screen; returns how many were culled
+    int advance(float speed, int ticks);
+    // AABB pre-test: writes the indices of obstacles whose box overlaps the
+    // given one to `out` (room for size() entries) and returns their count
+    int overlapping(float left, float top, float boxWidth, float boxHeight, int* out) const;
+
+private:
+    int count;
+    int limit;
+    int* culled;
+
+    void remove(int index);
+};
+
+#endif // OBSTACLEFIELD_H
@@ -0,0 +1,109 @@
+#ifndef OBSTACLES_H
+#define OBSTACLES_H
+
+#include <cstdint>
+
+enum ObstacleKind {
+    OBSTACLE_CACTUS,
+    OBSTACLE_PTERO
+};
+
+// Compact record shared by cacti and pterodactyls
+struct Obstacle {
+    float x;
+    float y;
+    float width;
+    float height;
+    std::uint8_t kind;
+    std::uint8_t type;            // cactus image, 0..CACTUS_TYPES-1
+    std::uint8_t frame;           // pterodactyl wing frame, 0 = down
+    std::uint8_t alive;
+    std::int32_t animationTicks;
+};
+
+const int MAX_OBSTACLES = 16;     // power of two; a screen holds at most ~8
+
+// Fixed-capacity FIFO of obstacles in spawn order. Everything scrolls left at
+// the same speed, so obstacles die roughly in order; one that dies behind a
+// live neighbour is only flagged, and popDead() reclaims it once it reaches
+// the front. No allocation ever happens after construction. setLimit() caps
+// how many it holds below Capacity.
+template <int Capacity>
+class BasicObstacleRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "ring capacity must be a power of two");
+
+public:
+    BasicObstacleRing() : head(0), count(0), pushes(0), drops(0), limit(Capacity) {}
+
+    void clear() {
+        head = 0;
+        count = 0;
+        pushes = 0;
+        drops = 0;
+    }
+
+    void setLimit(int limit) {
+        this->limit = limit < 1 ? 1 : (limit > Capacity ? Capacity : limit);
+    }
+
+    int size() const {
+        return count;
+    }
+
+    int capacity() const {
+        return limit;
+    }
+
+    bool full() const {
+        return count == limit;
+    }
+
+    // Obstacles pushed since clear(); the newest n are the last n entries
+    unsigned pushCount() const {
+        return pushes;
+    }
+
+    // Pushes refused since clear() because the ring was full
+    unsigned dropCount() const {
+        return drops;
+    }
+
+    // i-th oldest entry, dead or alive
+    Obstacle& operator[](int i) {
+        return items[(head + i) & (Capacity - 1)];
+    }
+
+    const Obstacle& operator[](int i) const {
+        return items[(head + i) & (Capacity - 1)];
+    }
+
+    bool push(const Obstacle& obstacle) {
+        if (full()) {
+            drops++;
+            return false;
+        }
+        items[(head + count) & (Capacity - 1)] = obstacle;
+        count++;
+        pushes++;
+        return true;
+    }
+
+    void popDead() {
+        while (count > 0 && !items[head].alive) {
+            head = (head + 1) & (Capacity - 1);
+            count--;
+        }
+    }
+
+private:
+    Obstacle items[Capacity];
+    int head;
+    int count;
+    unsigned pushes;
+    unsigned drops;
+    int limit;
+};
+
+typedef BasicObstacleRing<MAX_OBSTACLES> ObstacleRing;
+
+#endif // OBSTACLES_H
@@ -0,0 +1,28 @@
+#include "pacer.h"
+#include <algorithm>
+#include <thread>
+
+const FramePacer::Clock::duration MIN_SPIN = std::chrono::microseconds(500);
+const FramePacer::Clock::duration MAX_SPIN = std::chrono::milliseconds(4);
+const FramePacer::Clock::duration SPIN_SLACK = std::chrono::microseconds(200);
+
+FramePacer::FramePacer() : lastError(0), spin(std::chrono::microseconds(1500)) {
+}
+
+void FramePacer::waitUntil(Clock::time_point deadline) {
+    Clock::time_point now = Clock::now();
+    Clock::time_point wake = deadline - spin;
+    if (now < wake) {
+        std::this_thread::sleep_until(wake);
+        
+        // Grow to cover this overshoot at once, shrink by 1/64 per wait
+        Clock::duration overshoot = Clock::now() - wake;
+        spin = std::max(spin - spin / 64, overshoot + SPIN_SLACK);
+        spin = std::min(std::max(spin, MIN_SPIN), MAX_SPIN);
+    }
+    // Yield while spinning so a busy core still runs the other game thread
+    while ((now = Clock::now()) < deadline) {
+        std::this_thread::yield();
+    }
+    lastError = now - deadline;
+}
@@ -0,0 +1,23 @@
+#ifndef PACER_H
+#define PACER_H
+
+#include <chrono>
+
+// Waits for a deadline precisely: sleeps until shortly before it, since OS
+// sleeps routinely overshoot by a millisecond or more, then spin-waits the
+// rest. The spin margin follows the worst recent sleep overshoot, decaying
+// slowly, so a machine with bad timers spins longer and a good one barely.
+class FramePacer {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    FramePacer();
+    void waitUntil(Clock::time_point deadline);
+
+    // How late the last wait returned
+    Clock::duration lastError;
+    // Current spin margin
+    Clock::duration spin;
+};
+
+#endif // PACER_H
@@ -0,0 +1,77 @@
+// Writes the asset bundle the game maps at startup (see bundle.h):
+//   g++ -std=c++17 -O2 packassets.cpp assets.cpp atlas.cpp bundle.cpp parallel.cpp -o packassets -lsfml-graphics -lsfml-window -lsfml-system -pthread
+//   ./packassets dino.bundle
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include "assets.h"
+
+static std::uint32_t align4(std::size_t offset) {
+    return static_cast<std::uint32_t>((offset + 3) / 4 * 4);
+}
+
+int main(int argc, char* argv[]) {
+    const char* output = argc > 1 ? argv[1] : BUNDLE_FILE_NAME;
+    
+    std::vector<sf::Image> images(SPRITE_COUNT);
+    std::vector<sf::Vector2u> sizes(SPRITE_COUNT);
+    for (int i = 0; i < SPRITE_COUNT; ++i) {
+        if (!images[i].loadFromFile(SPRITE_FILES[i])) {
+            std::fprintf(stderr, "Failed to load %s\n", SPRITE_FILES[i]);
+            return 1;
+        }
+        sizes[i] = images[i].getSize();
+    }
+    
+    std::ifstream fontFile(FONT_FILE, std::ios::binary);
+    std::vector<char> font((std::istreambuf_iterator<char>(fontFile)), std::istreambuf_iterator<char>());
+    if (font.empty()) {
+        std::fprintf(stderr, "Failed to load %s, the bundle will have no font\n", FONT_FILE);
+    }
+    
+    // Same layout the game would build at runtime from the PNGs
+    std::vector<sf::IntRect> frames;
+    sf::Vector2u atlasSize = packFrames(sizes, frames);
+    
+    BundleHeader header = {};
+    std::copy(BUNDLE_MAGIC, BUNDLE_MAGIC + 4, header.magic);
+    header.version = BUNDLE_VERSION;
+    header.spriteCount = SPRITE_COUNT;
+    header.atlasWidth = atlasSize.x;
+    header.atlasHeight = atlasSize.y;
+    
+    std::vector<BundleSprite> sprites(SPRITE_COUNT);
+    std::size_t offset = sizeof(BundleHeader) + sizeof(BundleSprite) * SPRITE_COUNT;
+    for (int i = 0; i < SPRITE_COUNT; ++i) {
+        sprites[i].width = sizes[i].x;
+        sprites[i].height = sizes[i].y;
+        sprites[i].atlasX = frames[i].left;
+        sprites[i].atlasY = frames[i].top;
+        sprites[i].pixelOffset = static_cast<std::uint32_t>(offset);
+        offset += std::size_t(sizes[i].x) * sizes[i].y * 4;
+    }
+    header.fontOffset = align4(offset);
+    header.fontSize = static_cast<std::uint32_t>(font.size());
+    
+    std::ofstream file(output, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(sprites.data()), sizeof(BundleSprite) * sprites.size());
+    for (int i = 0; i < SPRITE_COUNT; ++i) {
+        file.write(reinterpret_cast<const char*>(images[i].getPixelsPtr()), std::size_t(sizes[i].x) * sizes[i].y * 4);
+    }
+    const char zeros[4] = {};
+    file.write(zeros, header.fontOffset - offset);
+    file.write(font.data(), font.size());
+    if (!file) {
+        std::fprintf(stderr, "Failed to write %s\n", output);
+        return 1;
+    }
+    
+    std::printf("Wrote %s: %d sprites, %ux%u atlas, %u byte font, %u bytes\n", output, SPRITE_COUNT,
+                atlasSize.x, atlasSize.y, header.fontSize, static_cast<unsigned>(header.fontOffset + font.size()));
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "parallel.h"
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+void WorkStealingQueue::push(const WorkRange& range) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ranges.push_back(range);
+}
+
+bool WorkStealingQueue::pop(WorkRange& range) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ranges.empty()) return false;
+    range = ranges.back();
+    ranges.pop_back();
+    return true;
+}
+
+bool WorkStealingQueue::steal(WorkRange& range) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ranges.empty()) return false;
+    range = ranges.front();
+    ranges.pop_front();
+    return true;
+}
+
+int hardwareThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+int parallelFor(int count, int chunkSize, int threads,
+                 const std::function<void(int, int, int)>& body) {
+    threads = std::max(1, std::min(threads, (count + chunkSize - 1) / std::max(1, chunkSize)));
+    
+    // Deal contiguous runs of chunks to each worker so they start on separate memory
+    std::vector<std::unique_ptr<WorkStealingQueue>> queues;
+    for (int i = 0; i < threads; ++i) {
+        queues.emplace_back(new WorkStealingQueue());
+    }
+    int chunks = (count + chunkSize - 1) / chunkSize;
+    for (int chunk = chunks - 1; chunk >= 0; --chunk) {
+        int begin = chunk * chunkSize;
+        int owner = static_cast<int>(static_cast<long long>(chunk) * threads / chunks);
+        queues[owner]->push({begin, std::min(count, begin + chunkSize)});
+    }
+    
+    // No task spawns new work, so a worker that finds every queue empty is done
+    auto worker = [&](int self) {
+        WorkRange range;
+        for (;;) {
+            bool found = queues[self]->pop(range);
+            for (int i = 1; !found && i < threads; ++i) {
+                found = queues[(self + i) % threads]->steal(range);
+            }
+            if (!found) return;
+            body(range.begin, range.end, self);
+        }
+    };
+    
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; ++i) {
+        pool.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return threads;
+}
@@ -0,0 +1,33 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <deque>
+#include <functional>
+#include <mutex>
+
+struct WorkRange {
+    int begin;
+    int end;
+};
+
+// Per-worker deque: the owner pops from the back, idle workers steal from the front
+class WorkStealingQueue {
+public:
+    void push(const WorkRange& range);
+    bool pop(WorkRange& range);
+    bool steal(WorkRange& range);
+
+private:
+    std::deque<WorkRange> ranges;
+    std::mutex mutex;
+};
+
+int hardwareThreads();
+
+// Splits [0, count) into chunks and runs body(begin, end, worker) on every
+// chunk across `threads` workers. Returns once all chunks are done, with the
+// number of workers used: never more than there are chunks.
+int parallelFor(int count, int chunkSize, int threads,
+                 const std::function<void(int, int, int)>& body);
+
+#endif // PARALLEL_H
@@ -0,0 +1,110 @@
+#include "planner.h"
+#include <chrono>
+#include <cstring>
+
+static double now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Everything that differs between branches of one search: the dino and the tick
+static std::uint64_t stateKey(const SimState& state) {
+    const Dino& dino = state.dino;
+    std::uint32_t y, velocity;
+    std::memcpy(&y, &dino.y, sizeof(y));
+    std::memcpy(&velocity, &dino.velocity, sizeof(velocity));
+
+    std::uint64_t key = 0xcbf29ce484222325ULL;
+    std::uint64_t parts[] = {
+        static_cast<std::uint64_t>(state.gameTicks), y, velocity,
+        static_cast<std::uint64_t>(dino.isJumping | dino.isDucking << 1 | dino.frame << 2),
+        static_cast<std::uint64_t>(dino.animationTicks | dino.animationState << 8)
+    };
+    for (std::uint64_t part : parts) {
+        key = (key ^ part) * 0x100000001b3ULL;
+        key ^= key >> 29;
+    }
+    return key | 1;    // 0 never names a state
+}
+
+Planner::Planner() : nodes(0), depth(0), stamp(0) {
+    std::memset(memoStamp, 0, sizeof(memoStamp));
+}
+
+// Returns false if the state was already reached in this pass
+bool Planner::visit(const SimState& state) {
+    std::uint64_t key = stateKey(state);
+    for (int probe = 0; probe < 8; ++probe) {
+        int slot = (key + probe) & (PLAN_MEMO_SIZE - 1);
+        if (memoStamp[slot] != stamp) {
+            memoStamp[slot] = stamp;
+            memo[slot] = key;
+            return true;
+        }
+        if (memo[slot] == key) return false;
+    }
+    return true;    // crowded neighbourhood: search it again rather than guess
+}
+
+// True if some action sequence from stack[level] survives to `horizon`
+bool Planner::search(int level, int horizon) {
+    if (level == horizon) return true;
+
+    const SimState& from = stack[level];
+    for (int action = 0; action < ACTION_COUNT; ++action) {
+        // Mid-air a jump does nothing, so it is the same branch as no input
+        if (action == ACTION_JUMP && from.dino.isJumping) continue;
+
+        if (checkTime && (nodes & 63) == 0 && now() > deadline) {
+            outOfTime = true;
+        }
+        if (outOfTime) return false;
+        nodes++;
+
+        work.restore(from);
+        applyAction(work, action);
+        for (int left = PLAN_SEGMENT_TICKS - from.gameTicks % PLAN_SEGMENT_TICKS; left > 0 && !work.gameOver; ) {
+            left -= work.advance(left);
+        }
+
+        if (level == 0) rootAction = action;
+        int ticks = work.gameTicks - stack[0].gameTicks;
+        if (ticks > survived[rootAction]) survived[rootAction] = ticks;
+        if (work.gameOver || !visit(work)) continue;
+
+        stack[level + 1] = work.snapshot();
+        if (search(level + 1, horizon)) return true;
+    }
+    return false;
+}
+
+int Planner::choose(const DinoSim& sim, double budgetSeconds) {
+    deadline = now() + budgetSeconds;
+    outOfTime = false;
+    nodes = 0;
+    depth = 0;
+    stack[0] = sim.snapshot();
+    for (int action = 0; action < ACTION_COUNT; ++action) {
+        survived[action] = -1;
+    }
+
+    // Deepen while time allows; the shallow first pass always runs to the end
+    int choice = -1;
+    for (int horizon = PLAN_MIN_DEPTH; ; horizon *= 2) {
+        if (horizon > PLAN_MAX_DEPTH) horizon = PLAN_MAX_DEPTH;
+        checkTime = horizon > PLAN_MIN_DEPTH;
+        stamp++;
+        if (!search(0, horizon)) break;
+
+        choice = rootAction;
+        depth = horizon;
+        if (horizon == PLAN_MAX_DEPTH) break;
+    }
+    if (choice >= 0) return choice;
+
+    // Nothing survives even the shortest horizon: put off the hit as long as possible
+    choice = ACTION_NONE;
+    for (int action = 0; action < ACTION_COUNT; ++action) {
+        if (survived[action] > survived[choice]) choice = action;
+    }
+    return choice;
+}
@@ -0,0 +1,47 @@
+#ifndef PLANNER_H
+#define PLANNER_H
+
+#include <cstdint>
+#include "dinosim.h"
+#include "vecenv.h"
+
+const int PLAN_SEGMENT_TICKS = 4;       // ticks each searched action is held
+const int PLAN_MIN_DEPTH = 8;           // segments, first deepening pass
+const int PLAN_MAX_DEPTH = 60;          // segments, 4 s of lookahead
+const int PLAN_MEMO_SIZE = 1 << 14;     // power of two
+
+// Lookahead autopilot: iterative-deepening DFS over none/jump/duck, each held
+// for a segment, on cloned SimStates. Segments end on multiples of
+// PLAN_SEGMENT_TICKS, so the plan found on one tick can still be followed from
+// the next. Obstacles do not depend on the player's input, so two branches
+// with the same dino at the same tick are the same state; the memo table drops
+// such repeats. Fixed-size buffers only, so a search never allocates.
+class Planner {
+public:
+    // Nodes (simulated segments) expanded by the last choose()
+    long long nodes;
+    // Deepest horizon, in segments, fully searched by the last choose()
+    int depth;
+
+    Planner();
+    // Returns an Action that survives as far ahead as the time budget allows
+    int choose(const DinoSim& sim, double budgetSeconds);
+
+private:
+    DinoSim work;
+    SimState stack[PLAN_MAX_DEPTH + 1];
+    std::uint64_t memo[PLAN_MEMO_SIZE];
+    std::uint32_t memoStamp[PLAN_MEMO_SIZE];
+    std::uint32_t stamp;
+
+    double deadline;
+    bool checkTime;
+    bool outOfTime;
+    int rootAction;
+    int survived[ACTION_COUNT];    // longest run seen under each first action
+
+    bool search(int level, int horizon);
+    bool visit(const SimState& state);
+};
+
+#endif // PLANNER_H
@@ -0,0 +1,64 @@
+#include "profiler.h"
+#include <algorithm>
+
+const char* const PROFILE_STAGE_NAMES[PROFILE_STAGE_COUNT] = {
+    "Frame", "Events", "Interpolate", "Build", "Draw", "Display",
+    "Sim wakeup", "Commands", "Bots", "Step", "Publish"
+};
+
+std::atomic<unsigned> profilingMode(0);
+
+// One writer per ring, read from the render thread: relaxed atomics keep that
+// race-free at the cost of a plain store
+struct StageRing {
+    std::atomic<float> samples[PROFILE_HISTORY];
+    std::atomic<unsigned> count;
+};
+
+static StageRing rings[PROFILE_STAGE_COUNT];
+
+void profileRecord(ProfileStage stage, float micros) {
+    StageRing& ring = rings[stage];
+    unsigned count = ring.count.load(std::memory_order_relaxed);
+    ring.samples[count & (PROFILE_HISTORY - 1)].store(micros, std::memory_order_relaxed);
+    ring.count.store(count + 1, std::memory_order_release);
+}
+
+void profileSpan(ProfileStage stage, unsigned mode, TraceClock::time_point start, TraceClock::time_point end) {
+    if (mode & PROFILE_OVERLAY) {
+        profileRecord(stage, std::chrono::duration<float, std::micro>(end - start).count());
+    }
+    if (mode & PROFILE_TRACE) {
+        traceComplete(PROFILE_STAGE_NAMES[stage], start, end);
+    }
+}
+
+int profileHistory(ProfileStage stage, float* out) {
+    const StageRing& ring = rings[stage];
+    unsigned count = ring.count.load(std::memory_order_acquire);
+    int size = static_cast<int>(std::min<unsigned>(count, PROFILE_HISTORY));
+    for (int i = 0; i < size; ++i) {
+        out[i] = ring.samples[(count - size + i) & (PROFILE_HISTORY - 1)].load(std::memory_order_relaxed);
+    }
+    return size;
+}
+
+StageStats profileStats(ProfileStage stage) {
+    float samples[PROFILE_HISTORY];
+    int size = profileHistory(stage, samples);
+    StageStats stats = {0, 0, 0, 0};
+    if (size == 0) return stats;
+    
+    stats.current = samples[size - 1];
+    float sum = 0;
+    for (int i = 0; i < size; ++i) {
+        sum += samples[i];
+    }
+    stats.average = sum / size;
+    
+    int rank = (size * 99) / 100;
+    std::nth_element(samples, samples + rank, samples + size);
+    stats.p99 = samples[rank];
+    stats.max = *std::max_element(samples, samples + size);
+    return stats;
+}
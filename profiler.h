@@ -0,0 +1,72 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include "trace.h"
+
+// Timed stages of the game loop. Render-thread stages first, then the
+// simulation thread's; each stage is only ever timed on one thread.
+enum ProfileStage {
+    PROFILE_FRAME,          // start to start of consecutive frames
+    PROFILE_EVENTS,
+    PROFILE_INTERPOLATE,
+    PROFILE_BUILD,
+    PROFILE_DRAW,
+    PROFILE_DISPLAY,
+    PROFILE_WAKEUP,         // one simulation wakeup, all stages below
+    PROFILE_COMMANDS,
+    PROFILE_BOTS,
+    PROFILE_STEP,
+    PROFILE_PUBLISH,
+    PROFILE_STAGE_COUNT
+};
+
+extern const char* const PROFILE_STAGE_NAMES[PROFILE_STAGE_COUNT];
+
+const int PROFILE_HISTORY = 256;    // samples kept per stage, power of two
+
+struct StageStats {
+    float current;    // microseconds
+    float average;
+    float p99;
+    float max;
+};
+
+// What timers feed: the overlay's rings, the trace, or both. Off by default;
+// while off, a timer is one relaxed load and a branch, so the
+// instrumentation can stay in every build.
+enum ProfileMode {
+    PROFILE_OVERLAY = 1,
+    PROFILE_TRACE = 2
+};
+
+extern std::atomic<unsigned> profilingMode;
+
+void profileRecord(ProfileStage stage, float micros);
+StageStats profileStats(ProfileStage stage);
+// Copies the stage's history oldest first; returns the number of samples
+int profileHistory(ProfileStage stage, float* out);
+
+// Records one stage run that went from start to end
+void profileSpan(ProfileStage stage, unsigned mode, TraceClock::time_point start, TraceClock::time_point end);
+
+// Times its own scope into a stage
+class ScopedTimer {
+public:
+    explicit ScopedTimer(ProfileStage stage)
+        : stage(stage), mode(profilingMode.load(std::memory_order_relaxed)) {
+        if (mode) start = TraceClock::now();
+    }
+
+    ~ScopedTimer() {
+        if (mode) profileSpan(stage, mode, start, TraceClock::now());
+    }
+
+private:
+    ProfileStage stage;
+    unsigned mode;
+    TraceClock::time_point start;
+};
+
+#endif // PROFILER_H
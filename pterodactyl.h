@@ -2,21 +2,20 @@
 #define PTERODACTYL_H
 
 #include <SFML/Graphics.hpp>
+#include "dinosim.h"
 
+// Sprite view of a simulated bird. The textures are shared handles owned by
+// Assets, so copying a Pterodactyl never copies pixels.
 class Pterodactyl {
 public:
     sf::Sprite sprite;
-    bool active;
-    float animationTimer;
-    bool currentFrame;
     
     Pterodactyl(const sf::Texture& downTex, const sf::Texture& upTex);
-    void update(float dt, float speed);
-    void spawn(float x, float y, float speed);
+    void sync(const Obstacle& obstacle);
 
 private:
-    sf::Texture downTexture;
-    sf::Texture upTexture;
+    const sf::Texture* downTexture;
+    const sf::Texture* upTexture;
 };
 
 #endif // PTERODACTYL_H
@@ -0,0 +1,130 @@
+#include "replay.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+const char REPLAY_MAGIC[4] = {'D', 'R', 'P', 'L'};
+const int REPLAY_VERSION = 1;
+
+static void writeVarint(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+static bool readVarint(const std::string& in, std::size_t& pos, std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+        unsigned char byte = static_cast<unsigned char>(in[pos++]);
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+static void applyEvent(DinoSim& sim, int type) {
+    switch (type) {
+        case REPLAY_JUMP: sim.jump(); break;
+        case REPLAY_DUCK_PRESS: sim.setDucking(true); break;
+        case REPLAY_DUCK_RELEASE: sim.setDucking(false); break;
+    }
+}
+
+Replay::Replay() : seed(0), finalTick(0), finalScore(0) {
+}
+
+void Replay::start(std::uint64_t seed) {
+    this->seed = seed;
+    finalTick = 0;
+    finalScore = 0;
+    events.clear();
+    events.reserve(REPLAY_RESERVED_EVENTS);
+}
+
+void Replay::record(const DinoSim& sim, int type) {
+    events.push_back({sim.gameTicks, type});
+}
+
+void Replay::finish(const DinoSim& sim) {
+    finalTick = sim.gameTicks;
+    finalScore = sim.score;
+}
+
+bool Replay::save(const std::string& path) const {
+    std::string data(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    data.push_back(static_cast<char>(REPLAY_VERSION));
+    writeVarint(data, seed);
+    writeVarint(data, finalTick);
+    writeVarint(data, finalScore);
+    writeVarint(data, events.size());
+    
+    int lastTick = 0;
+    for (const auto& event : events) {
+        writeVarint(data, (static_cast<std::uint64_t>(event.tick - lastTick) << 2) | event.type);
+        lastTick = event.tick;
+    }
+    
+    std::ofstream file(path, std::ios::binary);
+    file.write(data.data(), data.size());
+    return static_cast<bool>(file);
+}
+
+bool Replay::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < 5 || !std::equal(REPLAY_MAGIC, REPLAY_MAGIC + 4, data.begin()) ||
+        data[4] != REPLAY_VERSION) {
+        return false;
+    }
+    
+    std::size_t pos = 5;
+    std::uint64_t tick, score, count;
+    if (!readVarint(data, pos, seed) || !readVarint(data, pos, tick) ||
+        !readVarint(data, pos, score) || !readVarint(data, pos, count)) {
+        return false;
+    }
+    finalTick = static_cast<int>(tick);
+    finalScore = static_cast<int>(score);
+    
+    events.clear();
+    int lastTick = 0;
+    for (std::uint64_t i = 0; i < count; ++i) {
+        std::uint64_t packed;
+        if (!readVarint(data, pos, packed)) return false;
+        lastTick += static_cast<int>(packed >> 2);
+        events.push_back({lastTick, static_cast<int>(packed & 3)});
+    }
+    return true;
+}
+
+int Replay::applyEvents(DinoSim& sim, int cursor) const {
+    while (cursor < static_cast<int>(events.size()) && events[cursor].tick <= sim.gameTicks) {
+        applyEvent(sim, events[cursor].type);
+        cursor++;
+    }
+    return cursor;
+}
+
+// Runs in coarse steps between events; advance() keeps collisions exact
+int Replay::seek(DinoSim& sim, int tick) const {
+    sim.reset(seed);
+    int cursor = 0;
+    while (!sim.gameOver && sim.gameTicks < tick) {
+        cursor = applyEvents(sim, cursor);
+        int target = tick;
+        if (cursor < static_cast<int>(events.size())) {
+            target = std::min(target, events[cursor].tick);
+        }
+        sim.advance(std::max(1, target - sim.gameTicks));
+    }
+    return cursor;
+}
+
+// Replays are saved at game over. The fatal tick does not count towards
+// gameTicks, so seeking one past finalTick must end exactly there.
+bool Replay::verify(DinoSim& sim) const {
+    seek(sim, finalTick + 1);
+    return sim.gameOver && sim.gameTicks == finalTick && sim.score == finalScore;
+}
@@ -0,0 +1,53 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "dinosim.h"
+
+enum ReplayEventType {
+    REPLAY_JUMP,
+    REPLAY_DUCK_PRESS,
+    REPLAY_DUCK_RELEASE
+};
+
+// Recording reserves room for an hour of play at the most inputs a bot can
+// give in one tick (a jump and a duck toggle), so it does not allocate
+// mid-game until a game runs longer than that
+const int REPLAY_MAX_EVENTS_PER_TICK = 2;
+const int REPLAY_RESERVED_TICKS = 60 * 60 * TICKS_PER_SECOND;
+const int REPLAY_RESERVED_EVENTS = REPLAY_MAX_EVENTS_PER_TICK * REPLAY_RESERVED_TICKS;
+
+struct ReplayEvent {
+    int tick;
+    int type;
+};
+
+// One game: its seed plus every input, keyed by the tick it was applied
+// before. The file stores tick deltas and types packed into varints, so a
+// minute of play is typically a couple of hundred bytes.
+class Replay {
+public:
+    std::uint64_t seed;
+    int finalTick;
+    int finalScore;
+    std::vector<ReplayEvent> events;
+
+    Replay();
+    void start(std::uint64_t seed);
+    void record(const DinoSim& sim, int type);
+    void finish(const DinoSim& sim);
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    // Applies the events due at sim's current tick, starting from `cursor`;
+    // returns the cursor of the next pending event
+    int applyEvents(DinoSim& sim, int cursor) const;
+    // Re-simulates from the seed to `tick` (or game over); returns the cursor
+    int seek(DinoSim& sim, int tick) const;
+    // True if re-simulating ends in game over with the recorded tick and score
+    bool verify(DinoSim& sim) const;
+};
+
+#endif // REPLAY_H
@@ -0,0 +1,34 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+// PCG32 (XSH RR). Plain data, so copying a game state copies its random stream.
+class Rng {
+public:
+    std::uint64_t state;
+    std::uint64_t inc;
+
+    void seed(std::uint64_t seed, std::uint64_t stream = 0) {
+        state = 0;
+        inc = (stream << 1) | 1;
+        next();
+        state += seed;
+        next();
+    }
+
+    std::uint32_t next() {
+        std::uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        std::uint32_t xorshifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+        std::uint32_t rot = static_cast<std::uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+    // Uniform integer in [0, n)
+    int below(int n) {
+        return static_cast<int>((static_cast<std::uint64_t>(next()) * static_cast<std::uint32_t>(n)) >> 32);
+    }
+};
+
+#endif // RNG_H
@@ -0,0 +1,152 @@
+#include "dinosim.h"
+#include "parallel.h"
+#include "planner.h"
+#include "vecenv.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+const int DEFAULT_GAMES = 10000;
+const int DEFAULT_MAX_TICKS = 10 * 60 * TICKS_PER_SECOND;
+const int GAMES_PER_CHUNK = 64;
+const double PLAN_BUDGET_SECONDS = 0.001;
+
+struct RunnerOptions {
+    int games;
+    int threads;
+    std::uint64_t seed;
+    int maxTicks;
+    int stepTicks;
+    std::string policy;
+};
+
+// Jumps over anything on the ground and ducks under low birds
+int reflexPolicy(const float* obs) {
+    float reach = 0.1f * obs[OBS_SPEED];
+    if (obs[OBS_PTERO_DISTANCE] < reach && obs[OBS_PTERO_ALTITUDE] < 45.0f / WINDOW_HEIGHT) {
+        return obs[OBS_PTERO_ALTITUDE] < 0.05f ? ACTION_JUMP : ACTION_DUCK;
+    }
+    if (obs[OBS_CACTUS_DISTANCE] < reach) {
+        return ACTION_JUMP;
+    }
+    return ACTION_NONE;
+}
+
+int chooseAction(const std::string& policy, const float* obs, Rng& rng) {
+    if (policy == "reflex") return reflexPolicy(obs);
+    if (policy == "random") return rng.below(ACTION_COUNT);
+    return ACTION_NONE;
+}
+
+int percentile(const std::vector<int>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    std::size_t index = static_cast<std::size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+void usage() {
+    std::cerr << "Usage: runner [--games N] [--threads N] [--seed N] [--max-ticks N]\n"
+              << "              [--step-ticks N] [--policy idle|random|reflex|planner]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    RunnerOptions options;
+    options.games = DEFAULT_GAMES;
+    options.threads = hardwareThreads();
+    options.seed = 1;
+    options.maxTicks = DEFAULT_MAX_TICKS;
+    options.stepTicks = 1;
+    options.policy = "reflex";
+    
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+        if (std::strcmp(argv[i], "--games") == 0) options.games = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0) options.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--seed") == 0) options.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--max-ticks") == 0) options.maxTicks = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--step-ticks") == 0) options.stepTicks = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--policy") == 0) options.policy = argv[++i];
+        else {
+            usage();
+            return 1;
+        }
+    }
+    if (options.games < 1 || options.threads < 1 || options.stepTicks < 1) {
+        usage();
+        return 1;
+    }
+    
+    // Every game writes only its own slot, so workers never share results
+    std::vector<int> scores(options.games);
+    std::vector<int> ticks(options.games);
+    std::vector<long long> workerNodes(options.threads, 0);
+    bool planning = options.policy == "planner";
+    
+    auto start = std::chrono::steady_clock::now();
+    int workers = parallelFor(options.games, GAMES_PER_CHUNK, options.threads, [&](int begin, int end, int worker) {
+        DinoSim sim;
+        Planner planner;
+        Rng policyRng;
+        float obs[OBS_SIZE];
+        long long nodes = 0;    // summed locally: neighbouring workerNodes slots share a cache line
+        for (int game = begin; game < end; ++game) {
+            sim.reset(options.seed + game);
+            policyRng.seed(options.seed + game, 1);
+            // The policy decides once per --step-ticks; collisions are still exact
+            while (!sim.gameOver && sim.gameTicks < options.maxTicks) {
+                if (planning) {
+                    applyAction(sim, planner.choose(sim, PLAN_BUDGET_SECONDS));
+                    nodes += planner.nodes;
+                } else {
+                    observe(sim, obs);
+                    applyAction(sim, chooseAction(options.policy, obs, policyRng));
+                }
+                for (int left = options.stepTicks; left > 0 && !sim.gameOver; ) {
+                    left -= sim.advance(left);
+                }
+            }
+            scores[game] = sim.score;
+            ticks[game] = sim.gameTicks;
+        }
+        workerNodes[worker] += nodes;
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    long long totalTicks = 0;
+    double totalScore = 0;
+    for (int game = 0; game < options.games; ++game) {
+        totalTicks += ticks[game];
+        totalScore += scores[game];
+    }
+    std::sort(scores.begin(), scores.end());
+    std::sort(ticks.begin(), ticks.end());
+    
+    double games = options.games;
+    std::cout << "Policy:      " << options.policy << "\n"
+              << "Games:       " << options.games << " on " << workers << " threads\n"
+              << "Score:       mean " << totalScore / games
+              << ", p50 " << percentile(scores, 0.5)
+              << ", p90 " << percentile(scores, 0.9)
+              << ", p99 " << percentile(scores, 0.99)
+              << ", max " << (scores.empty() ? 0 : scores.back()) << "\n"
+              << "Survival:    mean " << totalTicks / games / TICKS_PER_SECOND << " s"
+              << ", p50 " << percentile(ticks, 0.5) / static_cast<double>(TICKS_PER_SECOND) << " s"
+              << ", p99 " << percentile(ticks, 0.99) / static_cast<double>(TICKS_PER_SECOND) << " s\n"
+              << "Throughput:  " << options.games / seconds << " games/s, "
+              << totalTicks / seconds << " ticks/s (" << seconds << " s)" << std::endl;
+    if (planning) {
+        long long nodes = 0;
+        for (long long count : workerNodes) nodes += count;
+        std::cout << "Planner:     " << nodes / seconds << " nodes/s, "
+                  << nodes / std::max(1.0, static_cast<double>(totalTicks)) << " nodes/tick" << std::endl;
+    }
+    return 0;
+}
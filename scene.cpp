@@ -0,0 +1,98 @@
+#include "scene.h"
+
+static bool onScreen(const Obstacle& obstacle) {
+    return obstacle.alive && obstacle.x < WINDOW_WIDTH && obstacle.x + obstacle.width > 0;
+}
+
+void appendRect(sf::VertexArray& quads, float x, float y, float width, float height, const sf::Color& color) {
+    quads.append(sf::Vertex(sf::Vector2f(x, y), color));
+    quads.append(sf::Vertex(sf::Vector2f(x + width, y), color));
+    quads.append(sf::Vertex(sf::Vector2f(x + width, y + height), color));
+    quads.append(sf::Vertex(sf::Vector2f(x, y + height), color));
+}
+
+template <int Capacity>
+void buildWorld(sf::VertexArray& world, const TextureAtlas& atlas, const BasicSimState<Capacity>& sim) {
+    world.clear();
+
+    const sf::IntRect& ground = atlas.getFrame(SPRITE_GROUND);
+    appendQuad(world, ground, -sim.groundOffset, WINDOW_HEIGHT - 12 + GROUND_OFFSET_Y);
+    appendQuad(world, ground, 1200 - sim.groundOffset, WINDOW_HEIGHT - 12 + GROUND_OFFSET_Y);
+
+    for (int i = 0; i < sim.obstacles.size(); ++i) {
+        const Obstacle& obstacle = sim.obstacles[i];
+        if (!onScreen(obstacle)) continue;
+
+        if (obstacle.kind == OBSTACLE_CACTUS) {
+            appendQuad(world, atlas.getFrame(SPRITE_CACTUS_1 + obstacle.type), obstacle.x, obstacle.y);
+        } else {
+            int frame = obstacle.frame ? SPRITE_PTERO_UP : SPRITE_PTERO_DOWN;
+            appendQuad(world, atlas.getFrame(frame), obstacle.x, obstacle.y, PTERO_SCALE);
+        }
+    }
+
+    appendQuad(world, atlas.getFrame(SPRITE_DINO_STAND + sim.dino.frame), sim.dino.x, sim.dino.y);
+}
+
+SpriteScene::SpriteScene(const Assets& assets)
+    : assets(assets), ptero(assets.textures[SPRITE_PTERO_DOWN], assets.textures[SPRITE_PTERO_UP]),
+      placeholders(sf::Quads) {
+}
+
+void SpriteScene::setGround() {
+    ground1.setTexture(assets.textures[SPRITE_GROUND], true);
+    ground2.setTexture(assets.textures[SPRITE_GROUND], true);
+}
+
+template <int Capacity>
+void SpriteScene::update(const BasicSimState<Capacity>& sim) {
+    ground1.setPosition(-sim.groundOffset, WINDOW_HEIGHT - 12 + GROUND_OFFSET_Y);
+    ground2.setPosition(1200 - sim.groundOffset, WINDOW_HEIGHT - 12 + GROUND_OFFSET_Y);
+
+    dino.setTexture(assets.textures[SPRITE_DINO_STAND + sim.dino.frame], true);
+    dino.setPosition(sim.dino.x, sim.dino.y);
+}
+
+template <int Capacity>
+int SpriteScene::draw(sf::RenderTarget& target, const BasicSimState<Capacity>& sim) {
+    target.draw(ground1);
+    target.draw(ground2);
+    int calls = 2;
+
+    placeholders.clear();
+    for (int i = 0; i < sim.obstacles.size(); ++i) {
+        const Obstacle& obstacle = sim.obstacles[i];
+        if (!onScreen(obstacle)) continue;
+
+        bool loaded = obstacle.kind == OBSTACLE_CACTUS
+                      ? assets.ready(SPRITE_CACTUS_1 + obstacle.type)
+                      : assets.ready(SPRITE_PTERO_DOWN) && assets.ready(SPRITE_PTERO_UP);
+        if (!loaded) {
+            appendRect(placeholders, obstacle.x, obstacle.y, obstacle.width, obstacle.height, PLACEHOLDER_COLOR);
+            continue;
+        }
+        if (obstacle.kind == OBSTACLE_CACTUS) {
+            cactus.setTexture(assets.textures[SPRITE_CACTUS_1 + obstacle.type], true);
+            cactus.setPosition(obstacle.x, obstacle.y);
+            target.draw(cactus);
+        } else {
+            ptero.sync(obstacle);
+            target.draw(ptero.sprite);
+        }
+        calls++;
+    }
+    if (placeholders.getVertexCount() > 0) {
+        target.draw(placeholders);
+        calls++;
+    }
+
+    target.draw(dino);
+    return calls + 1;
+}
+
+template void buildWorld(sf::VertexArray&, const TextureAtlas&, const BasicSimState<MAX_OBSTACLES>&);
+template void buildWorld(sf::VertexArray&, const TextureAtlas&, const BasicSimState<WIDE_MAX_OBSTACLES>&);
+template void SpriteScene::update(const BasicSimState<MAX_OBSTACLES>&);
+template void SpriteScene::update(const BasicSimState<WIDE_MAX_OBSTACLES>&);
+template int SpriteScene::draw(sf::RenderTarget&, const BasicSimState<MAX_OBSTACLES>&);
+template int SpriteScene::draw(sf::RenderTarget&, const BasicSimState<WIDE_MAX_OBSTACLES>&);
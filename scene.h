@@ -0,0 +1,47 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <SFML/Graphics.hpp>
+#include "assets.h"
+#include "dinosim.h"
+#include "pterodactyl.h"
+
+// Drawing the playfield, shared by DinoGame and the stress run so the
+// benchmark times the code the game draws with. Obstacles outside the
+// window are skipped.
+
+// Grey stand-in for anything that has not loaded yet
+const sf::Color PLACEHOLDER_COLOR(210, 210, 210);
+
+void appendRect(sf::VertexArray& quads, float x, float y, float width, float height, const sf::Color& color);
+
+// The ground, obstacles and dino as atlas quads, drawn with one call
+template <int Capacity>
+void buildWorld(sf::VertexArray& world, const TextureAtlas& atlas, const BasicSimState<Capacity>& sim);
+
+// The per-sprite path: one draw call per object, kept to compare against
+// the batch. Works while assets are still arriving; obstacles whose sprites
+// have not loaded are drawn as grey boxes.
+class SpriteScene {
+public:
+    explicit SpriteScene(const Assets& assets);
+    void setGround();    // once the ground texture is in
+
+    // Positions the ground and dino
+    template <int Capacity>
+    void update(const BasicSimState<Capacity>& sim);
+    // Returns the number of draw calls made
+    template <int Capacity>
+    int draw(sf::RenderTarget& target, const BasicSimState<Capacity>& sim);
+
+private:
+    const Assets& assets;
+    sf::Sprite dino;
+    sf::Sprite ground1;
+    sf::Sprite ground2;
+    sf::Sprite cactus;
+    Pterodactyl ptero;
+    sf::VertexArray placeholders;
+};
+
+#endif // SCENE_H
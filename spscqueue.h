@@ -0,0 +1,39 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+
+// Bounded lock-free queue for exactly one producer and one consumer thread.
+// CAPACITY must be a power of two; push() fails instead of blocking when full.
+template <typename T, unsigned CAPACITY>
+class SpscQueue {
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    // Producer side
+    bool push(const T& item) {
+        unsigned back = tail.load(std::memory_order_relaxed);
+        if (back - head.load(std::memory_order_acquire) == CAPACITY) return false;
+        items[back & (CAPACITY - 1)] = item;
+        tail.store(back + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T& item) {
+        unsigned front = head.load(std::memory_order_relaxed);
+        if (front == tail.load(std::memory_order_acquire)) return false;
+        item = items[front & (CAPACITY - 1)];
+        head.store(front + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+    T items[CAPACITY];
+    alignas(64) std::atomic<unsigned> head;    // next slot to pop, written by the consumer
+    alignas(64) std::atomic<unsigned> tail;    // next slot to push, written by the producer
+};
+
+#endif // SPSCQUEUE_H
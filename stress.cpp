@@ -0,0 +1,140 @@
+#include "stress.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <sys/resource.h>
+#include "alloccount.h"
+
+typedef std::chrono::steady_clock StressClock;
+
+static float micros(StressClock::time_point start, StressClock::time_point end) {
+    return std::chrono::duration<float, std::micro>(end - start).count();
+}
+
+static float percentileOf(std::vector<float> samples, double p) {
+    if (samples.empty()) return 0;
+    std::sort(samples.begin(), samples.end());
+    return samples[static_cast<std::size_t>(p * (samples.size() - 1) + 0.5)];
+}
+
+template <class T>
+static double averageOf(const std::vector<T>& samples) {
+    double sum = 0;
+    for (T sample : samples) {
+        sum += sample;
+    }
+    return samples.empty() ? 0 : sum / samples.size();
+}
+
+static SimSettings stressSettings(const StressOptions& options) {
+    SimSettings settings = DEFAULT_SIM_SETTINGS;
+    settings.cactusSpawnTicks = options.cactusTicks;
+    settings.cactusChance = 100;
+    settings.pteroSpawnTicks = options.pteroTicks;
+    settings.pteroChance = 100;
+    settings.pteroLimit = options.pool;
+    settings.obstacleLimit = options.pool;
+    settings.spawnX = options.worldWidth;
+    return settings;
+}
+
+StressRun::StressRun(const StressOptions& options)
+    : options(options),
+      window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Dino Game (stress)"),
+      sim(new WideDinoSim(options.seed, stressSettings(options))), world(sf::Quads),
+      sprites(assets), drawCalls(0) {
+    // Uncapped, so the frame time is the work and not the display
+    window.setVerticalSyncEnabled(false);
+    window.setFramerateLimit(0);
+    
+    sim->invincible = true;
+    frameTimes.reserve(options.frames);
+    updateTimes.reserve(options.frames);
+    renderTimes.reserve(options.frames);
+    drawCounts.reserve(options.frames);
+    obstacleCounts.reserve(options.frames);
+    
+    // Start at steady state: run until the first obstacles have crossed the world
+    for (float travelled = 0; travelled < options.worldWidth + 100; travelled += sim->obstacleSpeed) {
+        sim->advance(1);
+    }
+}
+
+void StressRun::render() {
+    window.clear(sf::Color::White);
+    if (options.sprites) {
+        sprites.update(*sim);
+        drawCalls = sprites.draw(window, *sim);
+    } else {
+        buildWorld(world, assets.atlas, *sim);
+        window.draw(world, &assets.atlas.getTexture());
+        drawCalls = 1;
+    }
+}
+
+int StressRun::run() {
+    if (!assets.start(options.bundlePath)) {
+        return 1;
+    }
+    while (!assets.complete()) {
+        if (!assets.poll()) return 1;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    sprites.setGround();
+    
+    unsigned long long allocationsBefore = allocationCount();
+    StressClock::time_point frameStart = StressClock::now();
+    for (int frame = 0; frame < options.frames && window.isOpen(); ++frame) {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                window.close();
+            }
+        }
+        
+        StressClock::time_point start = StressClock::now();
+        sim->advance(1);
+        StressClock::time_point updated = StressClock::now();
+        render();
+        StressClock::time_point rendered = StressClock::now();
+        window.display();
+        
+        StressClock::time_point end = StressClock::now();
+        updateTimes.push_back(micros(start, updated));
+        renderTimes.push_back(micros(updated, rendered));
+        frameTimes.push_back(micros(frameStart, end));
+        drawCounts.push_back(drawCalls);
+        obstacleCounts.push_back(sim->obstacles.size());
+        frameStart = end;
+    }
+    
+    report(allocationCount() - allocationsBefore);
+    return 0;
+}
+
+void StressRun::report(unsigned long long allocations) const {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    double peakMegabytes = usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    double peakMegabytes = usage.ru_maxrss / 1024.0;
+#endif
+    double simMegabytes = sizeof(WideDinoSim) / (1024.0 * 1024.0);
+    
+    std::cout << "Stress:      " << frameTimes.size() << " frames, " << (options.sprites ? "per-sprite" : "batched")
+              << ", cactus every " << options.cactusTicks << " ticks, bird every " << options.pteroTicks
+              << " ticks, pool " << sim->obstacles.capacity() << ", world " << options.worldWidth << " px" << std::endl;
+    std::cout << "Obstacles:   avg " << averageOf(obstacleCounts) << ", max "
+              << (obstacleCounts.empty() ? 0 : *std::max_element(obstacleCounts.begin(), obstacleCounts.end()))
+              << " live (" << sim->obstacles.dropCount() << " spawns dropped)" << std::endl;
+    std::cout << "Frame (ms):  avg " << averageOf(frameTimes) / 1000 << ", p50 " << percentileOf(frameTimes, 0.5) / 1000
+              << ", p99 " << percentileOf(frameTimes, 0.99) / 1000 << ", max " << percentileOf(frameTimes, 1) / 1000 << std::endl;
+    std::cout << "Update (ms): avg " << averageOf(updateTimes) / 1000 << ", p99 " << percentileOf(updateTimes, 0.99) / 1000
+              << "; render: avg " << averageOf(renderTimes) / 1000 << ", p99 " << percentileOf(renderTimes, 0.99) / 1000 << std::endl;
+    std::cout << "Draw calls:  avg " << averageOf(drawCounts) << ", max "
+              << (drawCounts.empty() ? 0 : *std::max_element(drawCounts.begin(), drawCounts.end())) << " per frame" << std::endl;
+    std::cout << "Memory:      peak RSS " << peakMegabytes << " MB, simulation " << simMegabytes << " MB, "
+              << allocations << " heap allocations during the run" << std::endl;
+}
@@ -0,0 +1,56 @@
+#ifndef STRESS_H
+#define STRESS_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "assets.h"
+#include "dinosim.h"
+#include "scene.h"
+
+struct StressOptions {
+    std::uint64_t seed;
+    std::string bundlePath;
+    int frames;               // frames to run, one simulation tick each
+    int cactusTicks;          // a cactus spawns this often
+    int pteroTicks;
+    int pool;                 // obstacles alive at once; spawns beyond it are dropped
+    float worldWidth;         // obstacles spawn here and scroll to the left edge
+    bool sprites;             // draw one sprite per object instead of one batch
+};
+
+// Benchmark of the update and render paths at scale: the game's own DinoSim
+// and scene code, with an invincible dino, a wide world and a spawn on
+// nearly every tick. Runs uncapped for a fixed number of frames, then
+// prints frame time, draw calls and memory. Obstacles beyond the window's
+// right edge are updated but not drawn.
+class StressRun {
+public:
+    explicit StressRun(const StressOptions& options);
+    int run();
+
+private:
+    StressOptions options;
+    sf::RenderWindow window;
+    Assets assets;
+    std::unique_ptr<WideDinoSim> sim;    // too big for the stack
+    
+    // Drawing
+    sf::VertexArray world;
+    SpriteScene sprites;
+    int drawCalls;
+    
+    // Per-frame samples, microseconds
+    std::vector<float> frameTimes;
+    std::vector<float> updateTimes;
+    std::vector<float> renderTimes;
+    std::vector<int> drawCounts;
+    std::vector<int> obstacleCounts;
+    
+    void render();
+    void report(unsigned long long allocations) const;
+};
+
+#endif // STRESS_H
@@ -0,0 +1,121 @@
+#include "trace.h"
+#include <atomic>
+#include <cstdio>
+
+const int TRACE_CHUNK_EVENTS = 8192;
+
+struct TraceEvent {
+    const char* name;
+    double start;       // microseconds since traceStart()
+    double duration;    // negative for instant events
+    long long value;
+};
+
+struct TraceChunk {
+    TraceEvent events[TRACE_CHUNK_EVENTS];
+    int count;
+    TraceChunk* next;
+};
+
+// One per thread, linked into a list that only ever grows
+struct TraceBuffer {
+    const char* threadName;
+    int threadId;
+    TraceChunk* first;
+    TraceChunk* last;
+    TraceBuffer* next;
+};
+
+static TraceClock::time_point traceEpoch;
+static std::atomic<TraceBuffer*> buffers(nullptr);
+static std::atomic<int> threadCount(0);
+static thread_local TraceBuffer* localBuffer = nullptr;
+static thread_local unsigned long long localAllocations = 0;
+
+static TraceBuffer& threadBuffer() {
+    if (!localBuffer) {
+        TraceBuffer* buffer = new TraceBuffer();
+        localAllocations++;
+        buffer->threadName = nullptr;
+        buffer->threadId = threadCount.fetch_add(1) + 1;
+        buffer->first = buffer->last = nullptr;
+        buffer->next = buffers.load(std::memory_order_relaxed);
+        while (!buffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release)) {
+        }
+        localBuffer = buffer;
+    }
+    return *localBuffer;
+}
+
+static void append(const char* name, double start, double duration, long long value) {
+    TraceBuffer& buffer = threadBuffer();
+    if (!buffer.last || buffer.last->count == TRACE_CHUNK_EVENTS) {
+        TraceChunk* chunk = new TraceChunk();
+        localAllocations++;
+        chunk->count = 0;
+        chunk->next = nullptr;
+        if (buffer.last) buffer.last->next = chunk;
+        else buffer.first = chunk;
+        buffer.last = chunk;
+    }
+    TraceEvent& event = buffer.last->events[buffer.last->count++];
+    event.name = name;
+    event.start = start;
+    event.duration = duration;
+    event.value = value;
+}
+
+static double sinceEpoch(TraceClock::time_point time) {
+    return std::chrono::duration<double, std::micro>(time - traceEpoch).count();
+}
+
+void traceStart() {
+    traceEpoch = TraceClock::now();
+}
+
+void traceThreadName(const char* name) {
+    threadBuffer().threadName = name;
+}
+
+void traceComplete(const char* name, TraceClock::time_point start, TraceClock::time_point end) {
+    append(name, sinceEpoch(start), sinceEpoch(end) - sinceEpoch(start), 0);
+}
+
+void traceInstant(const char* name, long long value) {
+    append(name, sinceEpoch(TraceClock::now()), -1, value);
+}
+
+unsigned long long traceThreadAllocations() {
+    return localAllocations;
+}
+
+long long traceWrite(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) return -1;
+    
+    long long written = 0;
+    bool first = true;
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (TraceBuffer* buffer = buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next) {
+        // Thread-name metadata records are not counted as events
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                     first ? "" : ",\n", buffer->threadId, buffer->threadName ? buffer->threadName : "Worker");
+        first = false;
+        for (TraceChunk* chunk = buffer->first; chunk; chunk = chunk->next) {
+            for (int i = 0; i < chunk->count; ++i) {
+                const TraceEvent& event = chunk->events[i];
+                if (event.duration >= 0) {
+                    std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                                 event.name, buffer->threadId, event.start, event.duration);
+                } else {
+                    std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"args\":{\"value\":%lld}}",
+                                 event.name, buffer->threadId, event.start, event.value);
+                }
+                written++;
+            }
+        }
+    }
+    std::fprintf(file, "\n]}\n");
+    bool ok = std::fclose(file) == 0;
+    return ok ? written : -1;
+}
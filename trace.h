@@ -0,0 +1,23 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+#include <string>
+
+// Chrome trace-event recording (chrome://tracing, ui.perfetto.dev). Every
+// thread appends to its own chunked buffer, so recording takes no locks;
+// the buffers are only read by traceWrite() once the other threads are done.
+// Names must be string literals or otherwise outlive the trace.
+typedef std::chrono::steady_clock TraceClock;
+
+void traceStart();
+void traceThreadName(const char* name);
+void traceComplete(const char* name, TraceClock::time_point start, TraceClock::time_point end);
+void traceInstant(const char* name, long long value);
+// Buffers and chunks recording has allocated on the calling thread
+unsigned long long traceThreadAllocations();
+// Writes every thread's events; returns the number of events written (not
+// counting thread-name metadata), or -1 on failure
+long long traceWrite(const std::string& path);
+
+#endif // TRACE_H
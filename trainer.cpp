@@ -0,0 +1,187 @@
+#include "dinosim.h"
+#include "genome.h"
+#include "parallel.h"
+#include "vecenv.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+const float INITIAL_SIGMA = 0.5f;
+
+struct TrainerOptions {
+    int population;
+    int generations;
+    int elite;
+    int courses;
+    int maxTicks;
+    int threads;
+    float sigma;
+    std::uint64_t seed;
+    std::string checkpointPath;
+    std::string resumePath;
+};
+
+// Standard normal sample (Box-Muller)
+float gaussian(Rng& rng) {
+    float u1 = (rng.next() + 1.0f) / 4294967296.0f;
+    float u2 = rng.next() / 4294967296.0f;
+    return std::sqrt(-2.0f * std::log(u1)) * std::cos(6.2831853f * u2);
+}
+
+void mutate(Genome& genome, float sigma, Rng& rng) {
+    for (float& weight : genome.weights) {
+        weight += sigma * gaussian(rng);
+    }
+}
+
+// Mean ticks survived over the generation's courses, acting every tick
+float evaluate(const Genome& genome, std::uint64_t firstSeed, const TrainerOptions& options, DinoSim& sim) {
+    float obs[OBS_SIZE];
+    long long ticks = 0;
+    for (int course = 0; course < options.courses; ++course) {
+        sim.reset(firstSeed + course);
+        while (!sim.gameOver && sim.gameTicks < options.maxTicks) {
+            observe(sim, obs);
+            applyAction(sim, genomeAction(genome, obs));
+            sim.step();
+        }
+        ticks += sim.gameTicks;
+    }
+    return static_cast<float>(ticks) / options.courses;
+}
+
+void usage() {
+    std::cerr << "Usage: trainer [--population N] [--generations N] [--elite N] [--courses N]\n"
+              << "               [--max-ticks N] [--threads N] [--sigma X] [--seed N]\n"
+              << "               [--checkpoint PATH] [--resume PATH]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    TrainerOptions options;
+    options.population = 256;
+    options.generations = 50;
+    options.elite = 16;
+    options.courses = 8;
+    options.maxTicks = 2 * 60 * TICKS_PER_SECOND;
+    options.threads = hardwareThreads();
+    options.sigma = 0.1f;
+    options.seed = 1;
+    options.checkpointPath = "best.genome";
+    
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+        if (std::strcmp(argv[i], "--population") == 0) options.population = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--generations") == 0) options.generations = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--elite") == 0) options.elite = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--courses") == 0) options.courses = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--max-ticks") == 0) options.maxTicks = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0) options.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--sigma") == 0) options.sigma = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--seed") == 0) options.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--checkpoint") == 0) options.checkpointPath = argv[++i];
+        else if (std::strcmp(argv[i], "--resume") == 0) options.resumePath = argv[++i];
+        else {
+            usage();
+            return 1;
+        }
+    }
+    options.population = std::max(2, options.population);
+    options.elite = std::max(1, std::min(options.elite, options.population));
+    options.courses = std::max(1, options.courses);
+    
+    Rng rng;
+    rng.seed(options.seed, 2);
+    
+    // Start from random weights, or from mutants of a checkpoint
+    std::vector<Genome> population(options.population);
+    int firstGeneration = 0;
+    // The genome in --checkpoint. Courses change every generation, so it is
+    // re-scored on the current ones and only replaced by a genome that beats it there.
+    Genome checkpoint;
+    bool haveCheckpoint = false;
+    if (!options.resumePath.empty()) {
+        Genome parent;
+        if (!loadGenome(options.resumePath, parent, &firstGeneration)) {
+            std::cerr << "Failed to load genome " << options.resumePath << std::endl;
+            return 1;
+        }
+        if (options.resumePath == options.checkpointPath) {
+            checkpoint = parent;
+            haveCheckpoint = true;
+        }
+        firstGeneration++;
+        for (int i = 0; i < options.population; ++i) {
+            population[i] = parent;
+            if (i > 0) mutate(population[i], options.sigma, rng);
+        }
+    } else {
+        for (Genome& genome : population) {
+            for (float& weight : genome.weights) {
+                weight = INITIAL_SIGMA * gaussian(rng);
+            }
+        }
+    }
+    
+    std::vector<float> fitness(options.population);
+    std::vector<int> ranking(options.population);
+    std::vector<Genome> parents(options.elite);
+    
+    for (int generation = firstGeneration; generation < firstGeneration + options.generations; ++generation) {
+        // Every genome of a generation runs the same courses, so fitness is comparable
+        std::uint64_t firstSeed = options.seed + static_cast<std::uint64_t>(generation) * options.courses;
+        
+        auto start = std::chrono::steady_clock::now();
+        float checkpointFitness = 0;
+        int jobs = options.population + (haveCheckpoint ? 1 : 0);
+        parallelFor(jobs, 1, options.threads, [&](int begin, int end, int) {
+            DinoSim sim;
+            for (int i = begin; i < end; ++i) {
+                if (i < options.population) fitness[i] = evaluate(population[i], firstSeed, options, sim);
+                else checkpointFitness = evaluate(checkpoint, firstSeed, options, sim);
+            }
+        });
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        std::iota(ranking.begin(), ranking.end(), 0);
+        std::stable_sort(ranking.begin(), ranking.end(), [&](int a, int b) { return fitness[a] > fitness[b]; });
+        
+        double totalTicks = 0;
+        for (float value : fitness) totalTicks += value * options.courses;
+        const Genome& best = population[ranking[0]];
+        float bestFitness = fitness[ranking[0]];
+        
+        std::cout << "Generation " << generation
+                  << ": best " << bestFitness / TICKS_PER_SECOND << " s"
+                  << ", mean " << totalTicks / options.courses / options.population / TICKS_PER_SECOND << " s"
+                  << ", " << totalTicks / seconds << " ticks/s" << std::endl;
+        
+        if (!haveCheckpoint || bestFitness > checkpointFitness) {
+            if (!saveGenome(options.checkpointPath, best, generation, bestFitness)) {
+                std::cerr << "Failed to write checkpoint " << options.checkpointPath << std::endl;
+                return 1;
+            }
+            checkpoint = best;
+            haveCheckpoint = true;
+        }
+        
+        // Elites survive unchanged; everyone else is a mutant of a random elite
+        for (int i = 0; i < options.elite; ++i) {
+            parents[i] = population[ranking[i]];
+        }
+        for (int i = 0; i < options.population; ++i) {
+            population[i] = parents[i < options.elite ? i : rng.below(options.elite)];
+            if (i >= options.elite) mutate(population[i], options.sigma, rng);
+        }
+    }
+    return 0;
+}
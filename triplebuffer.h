@@ -0,0 +1,48 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free hand-off of whole values from one writer thread to one reader
+// thread. The writer fills back() and publishes it; the reader picks up the
+// newest published value with update() and reads front() until the next
+// update(). Neither side ever waits, and a slow reader just skips values.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : middle(1), backIndex(0), frontIndex(2) {}
+
+    // Writer side
+    T& back() {
+        return slots[backIndex];
+    }
+
+    void publish() {
+        std::uint8_t old = middle.exchange(static_cast<std::uint8_t>(backIndex | FRESH), std::memory_order_acq_rel);
+        backIndex = old & INDEX_MASK;
+    }
+
+    // Reader side; returns false if nothing new was published
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        std::uint8_t old = middle.exchange(static_cast<std::uint8_t>(frontIndex), std::memory_order_acq_rel);
+        frontIndex = old & INDEX_MASK;
+        return true;
+    }
+
+    const T& front() const {
+        return slots[frontIndex];
+    }
+
+private:
+    static const std::uint8_t INDEX_MASK = 3;
+    static const std::uint8_t FRESH = 4;    // middle holds a value the reader has not taken
+
+    T slots[3];
+    alignas(64) std::atomic<std::uint8_t> middle;
+    alignas(64) int backIndex;     // writer only
+    alignas(64) int frontIndex;    // reader only
+};
+
+#endif // TRIPLEBUFFER_H
@@ -0,0 +1,97 @@
+#include "vecenv.h"
+
+const float GROUND_Y = WINDOW_HEIGHT - 7 + GROUND_OFFSET_Y;
+const float DEATH_REWARD = -1.0f;
+
+void applyAction(DinoSim& sim, int action) {
+    if (action == ACTION_JUMP) {
+        sim.jump();
+    }
+    sim.setDucking(action == ACTION_DUCK);
+}
+
+void observe(const DinoSim& sim, float* out) {
+    const FrameSize& dinoSize = DINO_FRAME_SIZES[sim.dino.frame];
+    
+    // Nearest obstacle of each kind whose right edge has not yet passed the dino
+    float cactusDistance = WINDOW_WIDTH;
+    float cactusHeight = 0;
+    float pteroDistance = WINDOW_WIDTH;
+    float pteroAltitude = 0;
+    for (int i = 0; i < sim.obstacles.size(); ++i) {
+        const Obstacle& obstacle = sim.obstacles[i];
+        float distance = obstacle.x - sim.dino.x;
+        if (!obstacle.alive || obstacle.x + obstacle.width < sim.dino.x) continue;
+        
+        if (obstacle.kind == OBSTACLE_CACTUS) {
+            if (distance < cactusDistance) {
+                cactusDistance = distance;
+                cactusHeight = obstacle.height;
+            }
+        } else if (distance < pteroDistance) {
+            pteroDistance = distance;
+            pteroAltitude = GROUND_Y - (obstacle.y + obstacle.height);
+        }
+    }
+    
+    out[OBS_DINO_HEIGHT] = (GROUND_Y - (sim.dino.y + dinoSize.height)) / WINDOW_HEIGHT;
+    out[OBS_DINO_VELOCITY] = sim.dino.velocity / -JUMP_FORCE;
+    out[OBS_CACTUS_DISTANCE] = cactusDistance / WINDOW_WIDTH;
+    out[OBS_CACTUS_HEIGHT] = cactusHeight / WINDOW_HEIGHT;
+    out[OBS_PTERO_DISTANCE] = pteroDistance / WINDOW_WIDTH;
+    out[OBS_PTERO_ALTITUDE] = pteroAltitude / WINDOW_HEIGHT;
+    out[OBS_SPEED] = sim.obstacleSpeed / INITIAL_OBSTACLE_SPEED;
+}
+
+VecEnv::VecEnv(int count)
+    : games(count), obs(count * OBS_SIZE), reward(count), done(count) {
+}
+
+int VecEnv::size() const {
+    return static_cast<int>(games.size());
+}
+
+void VecEnv::reset(const std::uint64_t* seeds) {
+    for (int i = 0; i < size(); ++i) {
+        games[i].reset(seeds[i]);
+        observe(games[i], &obs[i * OBS_SIZE]);
+        reward[i] = 0;
+        done[i] = 0;
+    }
+}
+
+// Survival earns one point per tick. A game that ends reports its final
+// observation, then restarts on the next step with seed + size() so every
+// slot walks its own sequence of courses.
+void VecEnv::step(const int* actions) {
+    const int count = size();
+    for (int i = 0; i < count; ++i) {
+        DinoSim& sim = games[i];
+        if (done[i]) {
+            sim.reset(sim.seed + count);
+        }
+        
+        applyAction(sim, actions[i]);
+        sim.step();
+        
+        observe(sim, &obs[i * OBS_SIZE]);
+        reward[i] = sim.gameOver ? DEATH_REWARD : 1.0f;
+        done[i] = sim.gameOver;
+    }
+}
+
+const float* VecEnv::observations() const {
+    return obs.data();
+}
+
+const float* VecEnv::rewards() const {
+    return reward.data();
+}
+
+const std::uint8_t* VecEnv::dones() const {
+    return done.data();
+}
+
+const DinoSim& VecEnv::game(int index) const {
+    return games[index];
+}
@@ -0,0 +1,51 @@
+#ifndef VECENV_H
+#define VECENV_H
+
+#include <cstdint>
+#include <vector>
+#include "dinosim.h"
+
+enum Action {
+    ACTION_NONE,
+    ACTION_JUMP,
+    ACTION_DUCK,
+    ACTION_COUNT
+};
+
+// Observation layout, all values normalized to roughly [-1, 1]
+enum Observation {
+    OBS_DINO_HEIGHT,
+    OBS_DINO_VELOCITY,
+    OBS_CACTUS_DISTANCE,
+    OBS_CACTUS_HEIGHT,
+    OBS_PTERO_DISTANCE,
+    OBS_PTERO_ALTITUDE,
+    OBS_SPEED,
+    OBS_SIZE
+};
+
+void applyAction(DinoSim& sim, int action);
+void observe(const DinoSim& sim, float* out);
+
+// Steps many independent games per call for bot training. Outputs are kept
+// as flat arrays: observations are count * OBS_SIZE floats, row per game.
+class VecEnv {
+public:
+    explicit VecEnv(int count);
+    int size() const;
+    void reset(const std::uint64_t* seeds);
+    void step(const int* actions);
+
+    const float* observations() const;
+    const float* rewards() const;
+    const std::uint8_t* dones() const;
+    const DinoSim& game(int index) const;
+
+private:
+    std::vector<DinoSim> games;
+    std::vector<float> obs;
+    std::vector<float> reward;
+    std::vector<std::uint8_t> done;
+};
+
+#endif // VECENV_H